@@ -0,0 +1,262 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CollectionCache.h"
+#include "CollectionInfo.h"
+#include "Item.h"
+#include "../Database/Configuration.h"
+#include "../Utility/Utils.h"
+#include "../Utility/Log.h"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sstream>
+#include <set>
+
+std::map<CollectionInfo *, std::string> CollectionCache::owned_;
+std::list<CollectionCache::Entry> CollectionCache::cached_;
+SDL_mutex *CollectionCache::mutex_ = NULL;
+unsigned int CollectionCache::size_ = 0;
+
+
+void CollectionCache::initialize(unsigned int size)
+{
+    if(!mutex_)
+    {
+        mutex_ = SDL_CreateMutex();
+    }
+    size_ = size;
+}
+
+
+void CollectionCache::deInitialize()
+{
+    if(mutex_) SDL_LockMutex(mutex_);
+    for(std::list<Entry>::iterator it = cached_.begin(); it != cached_.end(); ++it)
+    {
+        delete it->collection;
+    }
+    cached_.clear();
+    owned_.clear();
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    if(mutex_)
+    {
+        SDL_DestroyMutex(mutex_);
+        mutex_ = NULL;
+    }
+}
+
+
+CollectionInfo *CollectionCache::acquire(std::string name)
+{
+    CollectionInfo *collection = NULL;
+    std::string     stamp;
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    for(std::list<Entry>::iterator it = cached_.begin(); it != cached_.end(); ++it)
+    {
+        if(it->collection->name != name)
+        {
+            continue;
+        }
+
+        collection = it->collection;
+        stamp      = it->signature;
+        cached_.erase(it);
+        break;
+    }
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    if(!collection) return NULL;
+
+    // the files are checked without the lock so release() on the main thread
+    // never waits for the disk
+    if(signature(collection) != stamp)
+    {
+        Logger::write(Logger::ZONE_INFO, "CollectionCache", "Collection " + name + " changed on disk; rebuilding");
+        delete collection;
+        return NULL;
+    }
+
+    Logger::write(Logger::ZONE_INFO, "CollectionCache", "Reusing collection " + name);
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    owned_[collection] = stamp;
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    return collection;
+}
+
+
+void CollectionCache::track(CollectionInfo *collection)
+{
+    if(size_ == 0) return;
+
+    std::string stamp = signature(collection);
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    owned_[collection] = stamp;
+    if(mutex_) SDL_UnlockMutex(mutex_);
+}
+
+
+void CollectionCache::release(CollectionInfo *collection)
+{
+    if(!collection) return;
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    std::map<CollectionInfo *, std::string>::iterator it = owned_.find(collection);
+
+    // menus and collections built while caching was off are not ours to keep
+    if(it == owned_.end())
+    {
+        if(mutex_) SDL_UnlockMutex(mutex_);
+        delete collection;
+        return;
+    }
+
+    // kept with the signature it was built with; acquire() checks it against
+    // the disk, on the collection thread, before handing it out again
+    Entry entry;
+    entry.collection = collection;
+    entry.signature  = it->second;
+    owned_.erase(it);
+
+    cached_.push_front(entry);
+    while(cached_.size() > size_)
+    {
+        delete cached_.back().collection;
+        cached_.pop_back();
+    }
+    if(mutex_) SDL_UnlockMutex(mutex_);
+}
+
+
+std::string CollectionCache::signature(CollectionInfo *collection)
+{
+    std::string stamp;
+    std::set<CollectionInfo *> subs;
+
+    addCollection(stamp, collection, "");
+
+    for(std::vector<Item *>::iterator it = collection->items.begin(); it != collection->items.end(); ++it)
+    {
+        CollectionInfo *sub = (*it)->collectionInfo;
+        if(sub && sub != collection && subs.insert(sub).second)
+        {
+            addCollection(stamp, sub, collection->name);
+        }
+    }
+
+    addFile(stamp, Utils::combinePath(Configuration::absolutePath, "meta.db"));
+
+    return stamp;
+}
+
+
+void CollectionCache::addCollection(std::string &stamp, CollectionInfo *collection, std::string parent)
+{
+    std::string path = Utils::combinePath(Configuration::absolutePath, "collections", collection->name);
+
+    addFile(stamp, path);
+    addFile(stamp, Utils::combinePath(path, "include.txt"));
+    addFile(stamp, Utils::combinePath(path, "exclude.txt"));
+    addFile(stamp, Utils::combinePath(path, "exclude_all.txt"));
+    addFile(stamp, Utils::combinePath(path, "menu.txt"));
+    addDirectory(stamp, Utils::combinePath(path, "menu"), "");
+    addDirectory(stamp, Utils::combinePath(path, "info"), ".conf");
+
+    if(parent != "")
+    {
+        addFile(stamp, Utils::combinePath(Configuration::absolutePath, "collections", parent, collection->name + ".sub"));
+    }
+
+    std::string romPaths = collection->listpath;
+    std::string romPath;
+    std::istringstream ss(romPaths);
+    while(std::getline(ss, romPath, ';'))
+    {
+        addFile(stamp, romPath);
+    }
+
+    // favorites and lastplayed are written by RetroFE itself and are
+    // already current in memory, so only the other playlists count
+    std::string playlists = Utils::combinePath(path, "playlists");
+    DIR *dp = opendir(playlists.c_str());
+    struct dirent *dirp;
+
+    while(dp != NULL && (dirp = readdir(dp)) != NULL)
+    {
+        std::string file = dirp->d_name;
+        if(file == "." || file == ".." || file == "favorites.txt" || file == "lastplayed.txt")
+        {
+            continue;
+        }
+        addFile(stamp, Utils::combinePath(playlists, file));
+    }
+    if(dp)
+    {
+        closedir(dp);
+    }
+}
+
+
+// Stamps a directory and the files in it ending in extension ("" for all),
+// so files edited in place are noticed as well as added or removed ones
+void CollectionCache::addDirectory(std::string &stamp, std::string path, std::string extension)
+{
+    std::set<std::string> files;
+    DIR *dp = opendir(path.c_str());
+    struct dirent *dirp;
+
+    addFile(stamp, path);
+
+    while(dp != NULL && (dirp = readdir(dp)) != NULL)
+    {
+        std::string file = dirp->d_name;
+        if(file == "." || file == ".." || file.length() < extension.length() ||
+           file.compare(file.length() - extension.length(), extension.length(), extension) != 0)
+        {
+            continue;
+        }
+        files.insert(file);
+    }
+    if(dp)
+    {
+        closedir(dp);
+    }
+
+    for(std::set<std::string>::iterator it = files.begin(); it != files.end(); ++it)
+    {
+        addFile(stamp, Utils::combinePath(path, *it));
+    }
+}
+
+
+void CollectionCache::addFile(std::string &stamp, std::string path)
+{
+    struct stat info;
+
+    stamp += path;
+    if(stat(path.c_str(), &info) == 0)
+    {
+        stamp += "=" + std::to_string((long long)info.st_mtime) + ":" + std::to_string((long long)info.st_size) + ";";
+    }
+    else
+    {
+        stamp += "=-;";
+    }
+}
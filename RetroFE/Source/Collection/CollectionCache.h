@@ -0,0 +1,61 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <list>
+#include <map>
+
+class CollectionInfo;
+
+// Keeps collections that were left so going back into them does not
+// rebuild them. A collection is only reused while the files it was built
+// from (rom directories, include/exclude lists, sub collections, playlists,
+// the menu directory, the info/*.conf files and meta.db) are unchanged.
+// Only the size and modification time of each file are compared.
+class CollectionCache
+{
+public:
+    static void initialize(unsigned int size);
+    static void deInitialize();
+
+    // Hands out a cached collection, or NULL if it has to be built.
+    static CollectionInfo *acquire(std::string name);
+
+    // Remember what a freshly built collection was built from.
+    static void track(CollectionInfo *collection);
+
+    // Called instead of deleting a collection once a page is done with it.
+    static void release(CollectionInfo *collection);
+
+private:
+    struct Entry
+    {
+        CollectionInfo *collection;
+        std::string     signature;
+    };
+
+    static std::string signature(CollectionInfo *collection);
+    static void addCollection(std::string &signature, CollectionInfo *collection, std::string parent);
+    static void addDirectory(std::string &signature, std::string path, std::string extension);
+    static void addFile(std::string &signature, std::string path);
+
+    static std::map<CollectionInfo *, std::string> owned_;
+    static std::list<Entry>                         cached_;
+    static SDL_mutex                               *mutex_;
+    static unsigned int                             size_;
+};
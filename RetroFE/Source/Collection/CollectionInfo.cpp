@@ -45,9 +45,11 @@ CollectionInfo::CollectionInfo(std::string name,
     , metadataType(metadataType)
     , menusort(true)
     , subsSplit(false)
+    , sortIgnoreThe(false)
     , hasSubs(false)
     , metadataPath_(metadataPath)
 	, extensions_(extensions)
+    , itemIndexValid_(false)
 {
 }
 
@@ -172,51 +174,222 @@ std::string CollectionInfo::lowercaseName()
 void CollectionInfo::addSubcollection(CollectionInfo *newinfo)
 {
     items.insert(items.begin(), newinfo->items.begin(), newinfo->items.end());
+    itemIndexValid_ = false;
 }
 
+// Expects buildSortKeys to have run, so that no strings are built per comparison.
 bool CollectionInfo::itemIsLess(Item *lhs, Item *rhs)
 {
     if(lhs->leaf && !rhs->leaf) return true;
     if(!lhs->leaf && rhs->leaf) return false;
     if(lhs->collectionInfo->subsSplit && lhs->collectionInfo != rhs->collectionInfo)
-        return lhs->collectionInfo->lowercaseName() < rhs->collectionInfo->lowercaseName();
+        return lhs->collectionInfo->sortName < rhs->collectionInfo->sortName;
     if(!lhs->collectionInfo->menusort && !lhs->leaf && !rhs->leaf)
         return false;
-    return lhs->lowercaseFullTitle() < rhs->lowercaseFullTitle();
+    return lhs->sortKey < rhs->sortKey;
+}
+
+
+// Computes the keys used for sorting and letter jumps once per item: the
+// lowercase full title, optionally without a leading "the ", and the
+// lowercase name of the collection each item came from. Items that already
+// have a key keep it.
+void CollectionInfo::buildSortKeys()
+{
+    for(std::vector<Item *>::iterator it = items.begin(); it != items.end(); it++)
+    {
+        Item *item = *it;
+        if(!item->sortKey.empty())
+        {
+            continue;
+        }
+        item->sortKey = item->lowercaseFullTitle();
+        if(sortIgnoreThe && item->sortKey.compare(0, 4, "the ") == 0 && item->sortKey.length() > 4)
+        {
+            item->sortKey.erase(0, 4);
+        }
+        if(item->collectionInfo && item->collectionInfo->sortName.empty())
+        {
+            item->collectionInfo->sortName = item->collectionInfo->lowercaseName();
+        }
+    }
 }
 
 
 void CollectionInfo::sortItems()
 {
+    buildSortKeys();
     std::sort( items.begin(), items.end(), itemIsLess );
+    itemIndexValid_ = false;
 }
 
 
+void CollectionInfo::buildItemIndex()
+{
+    itemIndex_.clear();
+    collectionIndex_.clear();
+
+    for(std::vector<Item *>::iterator it = items.begin(); it != items.end(); it++)
+    {
+        (*it)->ordinal = it - items.begin();
+
+        std::string collectionName = (*it)->collectionInfo->name;
+        itemIndex_[collectionName + ":" + (*it)->name].push_back(*it);
+        collectionIndex_[collectionName].push_back(*it);
+    }
+
+    itemIndexValid_ = true;
+}
+
+
+// Returns the items named itemName that belong to collectionName, or all of
+// that collection's items for "*". NULL when nothing matches.
+std::vector<Item *> *CollectionInfo::findItems(std::string collectionName, std::string itemName)
+{
+    if(!itemIndexValid_)
+    {
+        buildItemIndex();
+    }
+
+    ItemIndex_T::iterator it;
+    if(itemName == "*")
+    {
+        it = collectionIndex_.find(collectionName);
+        return (it == collectionIndex_.end()) ? NULL : &it->second;
+    }
+
+    it = itemIndex_.find(collectionName + ":" + itemName);
+    return (it == itemIndex_.end()) ? NULL : &it->second;
+}
+
+
+// Playlists follow the order of items. Every playlist entry carries its
+// position in items, so this is a sort per playlist rather than a scan of
+// items per playlist entry; entries that are no longer in items are dropped.
 void CollectionInfo::sortPlaylists()
 {
     std::vector<Item *> *allItems = &items;
-    std::vector<Item *> toSortItems;
 
-    for ( Playlists_T::iterator itP = playlists.begin( ); itP != playlists.end( ); itP++ )
+    // ordinals go stale if items changed without invalidating the index
+    bool valid = itemIndexValid_;
+    for ( Playlists_T::iterator itP = playlists.begin( ); valid && itP != playlists.end( ); itP++ )
     {
-        if ( itP->second != allItems )
+        if ( itP->second == NULL || itP->second == allItems )
+            continue;
+
+        for(std::vector <Item *>::iterator itSort = itP->second->begin(); itSort != itP->second->end(); itSort++)
         {
-            toSortItems.clear();
-            for(std::vector <Item *>::iterator itSort = itP->second->begin(); itSort != itP->second->end(); itSort++)
+            if (!inItems(*itSort))
             {
-                toSortItems.push_back((*itSort));
+                valid = false;
+                break;
             }
-            itP->second->clear();
-            for(std::vector <Item *>::iterator itAll = allItems->begin(); itAll != allItems->end(); itAll++)
+        }
+    }
+    if (!valid)
+    {
+        buildItemIndex();
+    }
+
+    for ( Playlists_T::iterator itP = playlists.begin( ); itP != playlists.end( ); itP++ )
+    {
+        std::vector<Item *> *playlist = itP->second;
+        if ( playlist == NULL || playlist == allItems )
+            continue;
+
+        std::vector<Item *>::iterator itKeep = playlist->begin();
+        for(std::vector <Item *>::iterator itSort = playlist->begin(); itSort != playlist->end(); itSort++)
+        {
+            if (inItems(*itSort))
             {
-                for(std::vector <Item *>::iterator itSort = toSortItems.begin(); itSort != toSortItems.end(); itSort++)
-                {
-                    if ((*itAll) == (*itSort))
-                    {
-                        itP->second->push_back((*itAll));
-                    }
-                }
+                *itKeep++ = *itSort;
             }
         }
+        playlist->erase(itKeep, playlist->end());
+
+        if (!std::is_sorted(playlist->begin(), playlist->end(), ordinalIsLess))
+        {
+            std::stable_sort(playlist->begin(), playlist->end(), ordinalIsLess);
+        }
+    }
+}
+
+
+// Inserts item at its place in the items order. Returns false if the playlist
+// does not exist, already holds the item or the item is not in this collection.
+bool CollectionInfo::addToPlaylist(std::string playlist, Item *item)
+{
+    Playlists_T::iterator itP = playlists.find(playlist);
+    if(itP == playlists.end() || itP->second == NULL || itP->second == &items)
+    {
+        return false;
+    }
+
+    if(!itemIndexValid_ || !inItems(item))
+    {
+        itemIndexValid_ = false;
+        sortPlaylists();
+        if(!inItems(item))
+        {
+            return false;
+        }
+    }
+
+    std::vector<Item *> *list = itP->second;
+    std::vector<Item *>::iterator it = std::lower_bound(list->begin(), list->end(), item, ordinalIsLess);
+    if(it != list->end() && *it == item)
+    {
+        return false;
     }
+
+    list->insert(it, item);
+    return true;
+}
+
+
+// Returns false if the playlist does not hold the item.
+bool CollectionInfo::removeFromPlaylist(std::string playlist, Item *item)
+{
+    Playlists_T::iterator itP = playlists.find(playlist);
+    if(itP == playlists.end() || itP->second == NULL || itP->second == &items)
+    {
+        return false;
+    }
+
+    if(!itemIndexValid_ || !inItems(item))
+    {
+        itemIndexValid_ = false;
+        sortPlaylists();
+    }
+
+    std::vector<Item *> *list = itP->second;
+    std::vector<Item *>::iterator it;
+    if(inItems(item))
+    {
+        it = std::lower_bound(list->begin(), list->end(), item, ordinalIsLess);
+    }
+    else
+    {
+        it = std::find(list->begin(), list->end(), item);
+    }
+
+    if(it == list->end() || *it != item)
+    {
+        return false;
+    }
+
+    list->erase(it);
+    return true;
+}
+
+
+bool CollectionInfo::inItems(Item *item)
+{
+    return item->ordinal < items.size() && items[item->ordinal] == item;
+}
+
+
+bool CollectionInfo::ordinalIsLess(Item *lhs, Item *rhs)
+{
+    return lhs->ordinal < rhs->ordinal;
 }
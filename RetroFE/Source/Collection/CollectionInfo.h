@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 class Item;
 
@@ -28,12 +29,18 @@ public:
     virtual ~CollectionInfo();
     std::string settingsPath() const;
     bool Save();
+    void buildSortKeys();
     void sortItems();
     void sortPlaylists();
+    bool addToPlaylist(std::string playlist, Item *item);
+    bool removeFromPlaylist(std::string playlist, Item *item);
     void addSubcollection(CollectionInfo *info);
     void extensionList(std::vector<std::string> &extensions);
+    void buildItemIndex();
+    std::vector<Item *> *findItems(std::string collectionName, std::string itemName);
     std::string name;
     std::string lowercaseName();
+    std::string sortName; // lowercaseName(), filled in by buildSortKeys
     std::string listpath;
     bool saveRequest;
     std::string metadataType;
@@ -45,10 +52,20 @@ public:
 
     bool menusort;
     bool subsSplit;
+    bool sortIgnoreThe;
     bool hasSubs;
 private:
     std::string metadataPath_;
     std::string extensions_;
     static bool itemIsLess(Item *lhs, Item *rhs);
+    static bool ordinalIsLess(Item *lhs, Item *rhs);
+    bool inItems(Item *item);
+
+    // items by "<collection>:<item>" and by collection ("*" entries), in items order;
+    // building it also numbers Item::ordinal
+    typedef std::unordered_map<std::string, std::vector<Item *> > ItemIndex_T;
+    ItemIndex_T itemIndex_;
+    ItemIndex_T collectionIndex_;
+    bool itemIndexValid_;
 
 };
@@ -21,6 +21,7 @@
 #include "../Database/DB.h"
 #include "../Utility/Log.h"
 #include "../Utility/Utils.h"
+#include "../Utility/WorkQueue.h"
 #include <dirent.h>
 
 #if defined(__linux) || defined(__APPLE__)
@@ -325,6 +326,7 @@ bool CollectionInfoBuilder::ImportDirectory(CollectionInfo *info, std::string me
     // Read ROM directory if showMissing is false
     if (!showMissing || includeFilter.size() == 0)
     {
+        std::vector<std::string> rompaths;
         do
         {
              std::string rompath;
@@ -339,8 +341,9 @@ bool CollectionInfoBuilder::ImportDirectory(CollectionInfo *info, std::string me
                  rompath = path;
                  path    = "";
              }
-             ImportRomDirectory(rompath, info, includeFilter, excludeFilter, romHierarchy, emuarc);
+             rompaths.push_back(rompath);
         } while (path != "");
+        ImportRomDirectories(rompaths, info, includeFilter, excludeFilter, romHierarchy, emuarc);
     }
 
     while(includeFilter.size() > 0)
@@ -371,41 +374,35 @@ void CollectionInfoBuilder::addPlaylists(CollectionInfo *info)
 
     ImportBasicList(info, excludeAllFile, excludeAllFilter);
 
+    // resolve playlist entries through the name index instead of scanning all items per entry
+    info->buildItemIndex();
+
     if ( excludeAllFilter.size() > 0)
     {
-        info->playlists["all"] = new std::vector<Item *>();
-        for(std::vector<Item *>::iterator it = info->items.begin(); it != info->items.end(); it++)
+        std::unordered_set<Item *> excluded;
+        for(std::map<std::string, Item *>::iterator itex = excludeAllFilter.begin(); itex != excludeAllFilter.end(); itex++)
         {
-            bool found = false;
-            for(std::map<std::string, Item *>::iterator itex = excludeAllFilter.begin(); itex != excludeAllFilter.end(); itex++)
+            std::string collectionName;
+            std::string itemName;
+            splitPlaylistEntry(info, itex->first, collectionName, itemName);
+
+            std::vector<Item *> *matches = info->findItems(collectionName, itemName);
+            if(matches)
             {
-                std::string collectionName = info->name;
-                std::string itemName       = itex->first;
-                if (itemName.at(0) == '_') // name consists of _<collectionName>:<itemName>
-                {
-                     itemName.erase(0, 1); // Remove _
-                     size_t position = itemName.find(":");
-                     if (position != std::string::npos )
-                     {
-                         collectionName = itemName.substr(0, position);
-                         itemName       = itemName.erase(0, position+1);
-                     }
-                }
-                if ( ((*it)->name == itemName || itemName == "*") && (*it)->collectionInfo->name == collectionName )
-                {
-                    found = true;
-                }
+                excluded.insert(matches->begin(), matches->end());
             }
-            if ( !found )
+            delete itex->second;
+        }
+        excludeAllFilter.clear();
+
+        info->playlists["all"] = new std::vector<Item *>();
+        for(std::vector<Item *>::iterator it = info->items.begin(); it != info->items.end(); it++)
+        {
+            if(excluded.find(*it) == excluded.end())
             {
                 info->playlists["all"]->push_back((*it));
             }
         }
-        while(excludeAllFilter.size() > 0)
-        {
-            std::map<std::string, Item *>::iterator it = excludeAllFilter.begin();
-            excludeAllFilter.erase(it);
-        }
     }
     else
     {
@@ -448,27 +445,19 @@ void CollectionInfoBuilder::addPlaylists(CollectionInfo *info)
                 // add the playlist list 
                 for(std::map<std::string, Item *>::iterator it = playlistFilter.begin(); it != playlistFilter.end(); it++)
                 {
-                    std::string collectionName = info->name;
-                    std::string itemName       = it->first;
-                    if (itemName.at(0) == '_') // name consists of _<collectionName>:<itemName>
-                    {
-                         itemName.erase(0, 1); // Remove _
-                         size_t position = itemName.find(":");
-                         if (position != std::string::npos )
-                         {
-                             collectionName = itemName.substr(0, position);
-                             itemName       = itemName.erase(0, position+1);
-                         }
-                    }
+                    std::string collectionName;
+                    std::string itemName;
+                    splitPlaylistEntry(info, it->first, collectionName, itemName);
+
+                    std::vector<Item *> *matches = info->findItems(collectionName, itemName);
+                    if (!matches)
+                        continue;
 
-                    for(std::vector<Item *>::iterator it = info->items.begin(); it != info->items.end(); it++)
+                    for(std::vector<Item *>::iterator itm = matches->begin(); itm != matches->end(); itm++)
                     {
-                        if ( ((*it)->name == itemName || itemName == "*") && (*it)->collectionInfo->name == collectionName )
-                        {
-                            info->playlists[basename]->push_back((*it));
-                            if ( basename == "favorites" )
-                                (*it)->isFavorite = true;
-                        }
+                        info->playlists[basename]->push_back((*itm));
+                        if ( basename == "favorites" )
+                            (*itm)->isFavorite = true;
                     }
                 }
                 while ( playlistFilter.size( ) > 0 )
@@ -497,6 +486,25 @@ void CollectionInfoBuilder::addPlaylists(CollectionInfo *info)
 }
 
 
+// Playlist entries name an item of this collection, or _<collectionName>:<itemName>
+// for an item of one of its sub collections.
+void CollectionInfoBuilder::splitPlaylistEntry(CollectionInfo *info, std::string entry, std::string &collectionName, std::string &itemName)
+{
+    collectionName = info->name;
+    itemName       = entry;
+    if (!itemName.empty() && itemName.at(0) == '_')
+    {
+        itemName.erase(0, 1); // Remove _
+        size_t position = itemName.find(":");
+        if (position != std::string::npos )
+        {
+            collectionName = itemName.substr(0, position);
+            itemName       = itemName.erase(0, position+1);
+        }
+    }
+}
+
+
 void CollectionInfoBuilder::updateLastPlayedPlaylist(CollectionInfo *info, Item *item, int size)
 {
     std::string path = Utils::combinePath(Configuration::absolutePath, "collections", info->name, "playlists");
@@ -523,24 +531,20 @@ void CollectionInfoBuilder::updateLastPlayedPlaylist(CollectionInfo *info, Item
         if (info->playlists["lastplayed"]->size() >= static_cast<unsigned int>( size ))
             break;
 
-        std::string collectionName = info->name;
-        std::string itemName       = (*it)->name;
-        if (itemName.at(0) == '_') // name consists of _<collectionName>:<itemName>
-        {
-             itemName.erase(0, 1); // Remove _
-             size_t position = itemName.find(":");
-             if (position != std::string::npos )
-             {
-                 collectionName = itemName.substr(0, position);
-                 itemName       = itemName.erase(0, position+1);
-             }
-        }
+        std::string collectionName;
+        std::string itemName;
+        splitPlaylistEntry(info, (*it)->name, collectionName, itemName);
 
-        for(std::vector<Item *>::iterator it = info->items.begin(); it != info->items.end(); it++)
+        // lastplayed.txt only holds exact names, so "*" is not a wildcard here
+        std::vector<Item *> *matches = (itemName == "*") ? NULL : info->findItems(collectionName, itemName);
+        if (!matches)
+            continue;
+
+        for(std::vector<Item *>::iterator itm = matches->begin(); itm != matches->end(); itm++)
         {
-            if ( (*it)->name == itemName && (*it)->collectionInfo->name == collectionName && (*it) != item)
+            if ( (*itm) != item )
             {
-                info->playlists["lastplayed"]->push_back((*it));
+                info->playlists["lastplayed"]->push_back((*itm));
             }
         }
     }
@@ -613,16 +617,114 @@ void CollectionInfoBuilder::updateLastPlayedPlaylist(CollectionInfo *info, Item
 }
 
 
-void CollectionInfoBuilder::ImportRomDirectory(std::string path, CollectionInfo *info, std::map<std::string, Item *> includeFilter, std::map<std::string, Item *> excludeFilter, bool romHierarchy, bool emuarc)
+class CollectionInfoBuilder::RomScanJob : public WorkQueue::Job
+{
+public:
+    RomScanJob(CollectionInfoBuilder &builder, CollectionInfo *info, RomScan &scan)
+        : builder_(builder)
+        , info_(info)
+        , scan_(scan)
+    {
+    }
+
+    void run()
+    {
+        builder_.scanRomDirectory(scan_.path, info_, scan_);
+    }
+
+private:
+    CollectionInfoBuilder &builder_;
+    CollectionInfo        *info_;
+    RomScan               &scan_;
+};
+
+
+void CollectionInfoBuilder::ImportRomDirectories(std::vector<std::string> &paths, CollectionInfo *info, std::map<std::string, Item *> &includeFilter, std::map<std::string, Item *> &excludeFilter, bool romHierarchy, bool emuarc)
 {
 
-    DIR                               *dp;
-    struct dirent                     *dirp;
-    std::vector<std::string>           extensions;
-    std::vector<std::string>::iterator extensionsIt;
+    std::vector<std::string> extensions;
+    std::vector<RomScan>     scans(paths.size());
 
     info->extensionList(extensions);
 
+    for(unsigned int i = 0; i < paths.size(); ++i)
+    {
+        RomScan &scan      = scans[i];
+        scan.path          = paths[i];
+        scan.includeFilter = &includeFilter;
+        scan.excludeFilter = &excludeFilter;
+        scan.romHierarchy  = romHierarchy;
+        scan.emuarc        = emuarc;
+
+        for(std::vector<std::string>::iterator it = extensions.begin(); it != extensions.end(); ++it)
+        {
+            if (it->find(".") == std::string::npos)
+                scan.extensions.insert(*it);
+            else
+                scan.dottedExtensions.push_back(*it);
+        }
+    }
+
+    // The paths are independent directory walks; scan them side by side
+    if (scans.size() == 1)
+    {
+        scanRomDirectory(scans[0].path, info, scans[0]);
+    }
+    else
+    {
+        int scanThreads = 4;
+        (void)conf_.getProperty("collectionScanThreads", scanThreads);
+
+        std::vector<WorkQueue::Job *> jobs;
+        for(unsigned int i = 0; i < scans.size(); ++i)
+        {
+            jobs.push_back(new RomScanJob(*this, info, scans[i]));
+        }
+        WorkQueue::run(jobs, scanThreads);
+        for(unsigned int i = 0; i < jobs.size(); ++i)
+        {
+            delete jobs[i];
+        }
+    }
+
+    // Merge in path order; the first path that has a rom wins, and items
+    // already in the collection are not added twice
+    std::unordered_set<std::string> names;
+    names.reserve(info->items.size());
+    for(std::vector<Item *>::iterator it = info->items.begin(); it != info->items.end(); ++it)
+    {
+        names.insert((*it)->name);
+    }
+
+    for(unsigned int i = 0; i < scans.size(); ++i)
+    {
+        for(std::vector<Item *>::iterator it = scans[i].items.begin(); it != scans[i].items.end(); ++it)
+        {
+            Item *item = *it;
+            std::string basename = (emuarc) ? item->file : item->name;
+
+            if (names.find(basename) != names.end())
+            {
+                delete item;
+                continue;
+            }
+
+            names.insert(item->name);
+            info->items.push_back(item);
+        }
+    }
+
+    return;
+
+}
+
+
+void CollectionInfoBuilder::scanRomDirectory(std::string path, CollectionInfo *info, RomScan &scan)
+{
+
+    DIR           *dp;
+    struct dirent *dirp;
+
     dp = opendir(path.c_str());
 
     Logger::write(Logger::ZONE_INFO, "CollectionInfoBuilder", "Scanning directory \"" + path + "\"");
@@ -632,67 +734,78 @@ void CollectionInfoBuilder::ImportRomDirectory(std::string path, CollectionInfo
         return;
     }
 
-    while(dp != NULL && (dirp = readdir(dp)) != NULL)
+    while((dirp = readdir(dp)) != NULL)
     {
         std::string file = dirp->d_name;
 
-        // Check if the file is a directory or a file
-        struct stat sb;
-        if (romHierarchy && file != "." && file != ".." && stat( Utils::combinePath( path, file ).c_str(), &sb ) == 0 && S_ISDIR( sb.st_mode ))
-        {
-            ImportRomDirectory( Utils::combinePath( path, file ), info, includeFilter, excludeFilter, romHierarchy, emuarc );
-        }
-        else if (file != "." && file != "..")
+        if (file == "." || file == "..")
+            continue;
+
+        // Check if the file is a directory or a file; only stat when readdir could not tell
+        if (scan.romHierarchy)
         {
-            size_t position = file.find_last_of(".");
-            std::string basename = (std::string::npos == position)? file : file.substr(0, position);
-        
-            // if there is an include list, only include roms that are found and are in the include list
-            // if there is an exclude list, exclude those roms
-            if ((includeFilter.size() == 0 || (includeFilter.find(basename) != includeFilter.end())) &&
-                    (excludeFilter.size() == 0 || excludeFilter.find(basename) == excludeFilter.end()))
+            bool isDir = false;
+#if defined(DT_DIR) && defined(DT_UNKNOWN) && defined(DT_LNK)
+            if (dirp->d_type == DT_DIR)
             {
-                // iterate through all known file extensions
-                for(extensionsIt = extensions.begin(); extensionsIt != extensions.end(); ++extensionsIt)
-                {
-                    std::string comparator = "." + *extensionsIt;
-                    int start = file.length() - comparator.length() + 1;
+                isDir = true;
+            }
+            else if (dirp->d_type == DT_UNKNOWN || dirp->d_type == DT_LNK)
+#endif
+            {
+                struct stat sb;
+                isDir = (stat( Utils::combinePath( path, file ).c_str(), &sb ) == 0 && S_ISDIR( sb.st_mode ));
+            }
 
-                    if (start >= 0)
-                    {
-                        if (file.compare(start, comparator.length(), *extensionsIt) == 0)
-                        {
-                            Item *i = new Item();
-
-                            i->name           = basename;
-                            i->fullTitle      = basename;
-                            i->title          = basename;
-                            i->collectionInfo = info;
-                            i->filepath       = path + Utils::pathSeparator;
-
-                            if ( emuarc )
-                            {
-                                i->file      = basename;
-                                i->name      = Utils::getFileName( path );
-                                i->fullTitle = i->name;
-                                i->title     = i->name;
-                            }
-
-                            // Add item if it doesn't already exist
-                            bool found = false;
-                            for ( std::vector<Item*>::iterator it = info->items.begin(); it != info->items.end( ); it++ )
-                               if ( (*it)->name == basename )
-                                   found = true;
-                            if ( !found )
-                                info->items.push_back(i);
-                        }
-                    }
-                }
+            if (isDir)
+            {
+                scanRomDirectory( Utils::combinePath( path, file ), info, scan );
+                continue;
             }
         }
+
+        size_t position = file.find_last_of(".");
+        std::string basename = (std::string::npos == position)? file : file.substr(0, position);
+
+        // if there is an include list, only include roms that are found and are in the include list
+        // if there is an exclude list, exclude those roms
+        if ((scan.includeFilter->size() > 0 && scan.includeFilter->find(basename) == scan.includeFilter->end()) ||
+                (scan.excludeFilter->size() > 0 && scan.excludeFilter->find(basename) != scan.excludeFilter->end()))
+        {
+            continue;
+        }
+
+        bool match = (position != std::string::npos && scan.extensions.find(file.substr(position + 1)) != scan.extensions.end());
+        for(std::vector<std::string>::iterator it = scan.dottedExtensions.begin(); !match && it != scan.dottedExtensions.end(); ++it)
+        {
+            match = (file.length() > it->length() && file.compare(file.length() - it->length(), it->length(), *it) == 0);
+        }
+
+        if (!match)
+        {
+            continue;
+        }
+
+        Item *i = new Item();
+
+        i->name           = basename;
+        i->fullTitle      = basename;
+        i->title          = basename;
+        i->collectionInfo = info;
+        i->filepath       = path + Utils::pathSeparator;
+
+        if ( scan.emuarc )
+        {
+            i->file      = basename;
+            i->name      = Utils::getFileName( path );
+            i->fullTitle = i->name;
+            i->title     = i->name;
+        }
+
+        scan.items.push_back(i);
     }
 
-    if (dp) closedir(dp);
+    closedir(dp);
 
     return;
 
@@ -704,3 +817,56 @@ void CollectionInfoBuilder::injectMetadata(CollectionInfo *info)
     metaDB_.injectMetadata(info);
     return;
 }
+
+
+class CollectionInfoBuilder::SubcollectionJob : public WorkQueue::Job
+{
+public:
+    SubcollectionJob(CollectionInfoBuilder &builder, std::string name, std::string parent, bool subsSplit)
+        : collection(NULL)
+        , builder_(builder)
+        , name_(name)
+        , parent_(parent)
+        , subsSplit_(subsSplit)
+    {
+    }
+
+    void run()
+    {
+        collection = builder_.buildCollection(name_, parent_);
+        collection->subsSplit = subsSplit_;
+        builder_.injectMetadata(collection);
+    }
+
+    CollectionInfo *collection;
+
+private:
+    CollectionInfoBuilder &builder_;
+    std::string            name_;
+    std::string            parent_;
+    bool                   subsSplit_;
+};
+
+
+// Build the sub collections side by side, then merge them in the order given
+void CollectionInfoBuilder::addSubcollections(CollectionInfo *info, std::vector<std::string> &names, bool subsSplit)
+{
+    std::vector<WorkQueue::Job *> jobs;
+
+    for(std::vector<std::string>::iterator it = names.begin(); it != names.end(); ++it)
+    {
+        jobs.push_back(new SubcollectionJob(*this, *it, info->name, subsSplit));
+    }
+
+    int scanThreads = 4;
+    (void)conf_.getProperty("collectionScanThreads", scanThreads);
+    WorkQueue::run(jobs, scanThreads);
+
+    for(std::vector<WorkQueue::Job *>::iterator it = jobs.begin(); it != jobs.end(); ++it)
+    {
+        SubcollectionJob *job = static_cast<SubcollectionJob *>(*it);
+        info->addSubcollection(job->collection);
+        info->hasSubs = true;
+        delete job;
+    }
+}
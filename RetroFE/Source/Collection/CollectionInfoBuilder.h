@@ -19,6 +19,7 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <unordered_set>
 
 class Configuration;
 class CollectionInfo;
@@ -34,6 +35,7 @@ public:
     void addPlaylists(CollectionInfo *info);
     void updateLastPlayedPlaylist(CollectionInfo *info, Item *item, int size);
     void injectMetadata(CollectionInfo *info);
+    void addSubcollections(CollectionInfo *info, std::vector<std::string> &names, bool subsSplit);
     static bool createCollectionDirectory(std::string collectionName);
     bool ImportBasicList(CollectionInfo *info, std::string file, std::vector<Item *> &list);
 
@@ -42,5 +44,22 @@ private:
     MetadataDatabase &metaDB_;
     bool ImportBasicList(CollectionInfo *info, std::string file, std::map<std::string, Item *> &list);
     bool ImportDirectory(CollectionInfo *info, std::string mergedCollectionName);
-    void ImportRomDirectory(std::string path, CollectionInfo *info, std::map<std::string, Item *> includeFilter, std::map<std::string, Item *> excludeFilter, bool romHierarchy, bool emuarc);
+    static void splitPlaylistEntry(CollectionInfo *info, std::string entry, std::string &collectionName, std::string &itemName);
+    void ImportRomDirectories(std::vector<std::string> &paths, CollectionInfo *info, std::map<std::string, Item *> &includeFilter, std::map<std::string, Item *> &excludeFilter, bool romHierarchy, bool emuarc);
+
+    // one rom path being scanned; paths are scanned in parallel and merged in order
+    struct RomScan
+    {
+        std::string                     path;
+        std::map<std::string, Item *>  *includeFilter;
+        std::map<std::string, Item *>  *excludeFilter;
+        bool                            romHierarchy;
+        bool                            emuarc;
+        std::unordered_set<std::string> extensions;       // extensions without a '.'
+        std::vector<std::string>        dottedExtensions; // e.g. "tar.gz"; matched on the suffix
+        std::vector<Item *>             items;            // matches in directory order, not yet deduplicated
+    };
+    class RomScanJob;
+    class SubcollectionJob;
+    void scanRomDirectory(std::string path, CollectionInfo *info, RomScan &scan);
 };
@@ -24,6 +24,7 @@
 Item::Item()
     : collectionInfo(NULL)
     , leaf(true)
+    , ordinal(0)
 {
     file = "";
     isFavorite = false;
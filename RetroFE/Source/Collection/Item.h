@@ -18,6 +18,7 @@
 #include <string>
 #include <map>
 #include "CollectionInfo.h"
+#include "../Utility/InternedString.h"
 
 class Item
 {
@@ -28,24 +29,27 @@ public:
     std::string lowercaseTitle() ;
     std::string lowercaseFullTitle();
     std::string name;
-    std::string filepath;
+    InternedString filepath;
     std::string file;
     std::string title;
     std::string fullTitle;
-    std::string year;
-    std::string manufacturer;
-    std::string developer;
-    std::string genre;
-    std::string cloneof;
-    std::string numberPlayers;
-    std::string numberButtons;
-    std::string ctrlType;
-    std::string joyWays;
-    std::string rating;
-    std::string score;
+    // metadata repeats across a collection; see InternedString
+    InternedString year;
+    InternedString manufacturer;
+    InternedString developer;
+    InternedString genre;
+    InternedString cloneof;
+    InternedString numberPlayers;
+    InternedString numberButtons;
+    InternedString ctrlType;
+    InternedString joyWays;
+    InternedString rating;
+    InternedString score;
     bool        isFavorite;
     CollectionInfo *collectionInfo;
     bool leaf;
+    std::string sortKey; // collation key of fullTitle; see CollectionInfo::buildSortKeys
+    size_t ordinal; // position in the collection's items, used to keep playlists in that order
 
     typedef std::map<std::string, std::string> InfoType;
     typedef std::pair<std::string, std::string> InfoPair;
@@ -0,0 +1,88 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "JumpIndex.h"
+
+JumpIndex::JumpIndex()
+    : size_(0)
+{
+}
+
+
+void JumpIndex::build(std::vector<int> &classes)
+{
+    clear();
+    size_ = classes.size();
+    run_.reserve(size_);
+
+    for(unsigned int i = 0; i < size_; ++i)
+    {
+        if(runClass_.empty() || runClass_.back() != classes[i])
+        {
+            runStart_.push_back(i);
+            runClass_.push_back(classes[i]);
+        }
+        run_.push_back(runStart_.size() - 1);
+    }
+}
+
+
+void JumpIndex::clear()
+{
+    size_ = 0;
+    run_.clear();
+    runStart_.clear();
+    runClass_.clear();
+}
+
+
+unsigned int JumpIndex::size()
+{
+    return size_;
+}
+
+
+// Number of steps forward from position to the first entry of another class,
+// or 0 if the whole list shares one class.
+unsigned int JumpIndex::stepsForward(unsigned int position)
+{
+    if(runClass_.size() < 2) return 0;
+
+    unsigned int run  = run_[position];
+    unsigned int last = runClass_.size() - 1;
+
+    if(run < last) return runStart_[run + 1] - position;
+
+    // the last run continues into the first one when they share a class
+    if(runClass_[last] != runClass_[0]) return size_ - position;
+    return size_ - position + runStart_[1];
+}
+
+
+// Number of steps back from position to the first entry of another class,
+// or 0 if the whole list shares one class.
+unsigned int JumpIndex::stepsBackward(unsigned int position)
+{
+    if(runClass_.size() < 2) return 0;
+
+    unsigned int run  = run_[position];
+    unsigned int last = runClass_.size() - 1;
+
+    if(run > 0) return position - runStart_[run] + 1;
+
+    // the first run continues into the last one when they share a class
+    if(runClass_[last] != runClass_[0]) return position + 1;
+    return position + 1 + size_ - runStart_[last];
+}
@@ -0,0 +1,39 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <vector>
+
+// Splits a list into runs of consecutive entries that share a class (e.g. the
+// first letter of the title, or the collection an item came from), so the
+// distance to the next or previous class change is a lookup instead of a walk.
+// The list is treated as circular, like the scrolling list it serves.
+class JumpIndex
+{
+public:
+    JumpIndex();
+    void build(std::vector<int> &classes);
+    void clear();
+    unsigned int size();
+    unsigned int stepsForward(unsigned int position);
+    unsigned int stepsBackward(unsigned int position);
+
+private:
+    unsigned int              size_;
+    std::vector<unsigned int> run_;      // run of each position
+    std::vector<unsigned int> runStart_; // first position of each run
+    std::vector<int>          runClass_;
+};
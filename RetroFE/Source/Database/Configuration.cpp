@@ -35,11 +35,19 @@
 std::string Configuration::absolutePath;
 
 Configuration::Configuration()
+    : generation_(0)
+    , basePathsValid_(false)
+    , mutex_(SDL_CreateMutex())
 {
 }
 
 Configuration::~Configuration()
 {
+    if(mutex_)
+    {
+        SDL_DestroyMutex(mutex_);
+        mutex_ = NULL;
+    }
 }
 
 void Configuration::initialize()
@@ -99,7 +107,11 @@ void Configuration::initialize()
 
 void Configuration::clearProperties( )
 {
+    SDL_LockMutex( mutex_ );
     properties_.clear( );
+    generation_++;
+    basePathsValid_ = false;
+    SDL_UnlockMutex( mutex_ );
 }
 
 
@@ -179,7 +191,12 @@ bool Configuration::parseLine(std::string collection, std::string keyPrefix, std
         {
             value = Utils::replace(value, "%ITEM_COLLECTION_NAME%", collection);
         }
-        properties_.insert(PropertiesPair(key, value));
+        SDL_LockMutex(mutex_);
+        if(properties_.insert(PropertiesPair(key, value)).second)
+        {
+            invalidate(key);
+        }
+        SDL_UnlockMutex(mutex_);
 
         std::stringstream ss;
         ss << "Dump: "  << "\"" << key << "\" = \"" << value << "\"";
@@ -213,38 +230,38 @@ std::string Configuration::trimEnds(std::string str)
     return str;
 }
 
-bool Configuration::getRawProperty(std::string key, std::string &value)
+bool Configuration::getProperty(std::string key, std::string &value)
 {
     bool retVal = false;
 
-    if(properties_.find(key) != properties_.end())
+    SDL_LockMutex(mutex_);
+    PropertiesType::iterator it = properties_.find(key);
+    if(it != properties_.end())
     {
-        value = properties_[key];
-
+        value = it->second;
         retVal = true;
     }
+    value = expand(value);
+    SDL_UnlockMutex(mutex_);
 
     return retVal;
 }
-bool Configuration::getProperty(std::string key, std::string &value)
-{
-    bool retVal = getRawProperty(key, value);
 
-    std::string baseMediaPath = absolutePath;
-    std::string baseItemPath  = absolutePath;
+bool Configuration::getProperty(std::string key, int &value)
+{
+    std::string strValue;
 
-    baseMediaPath = Utils::combinePath(absolutePath, "collections");
-    baseItemPath  = Utils::combinePath(absolutePath, "collections");
+    bool retVal = getProperty(key, strValue);
 
-    getRawProperty("baseMediaPath", baseMediaPath);
-    getRawProperty("baseItemPath", baseItemPath);
+    if(retVal)
+    {
+        value = toInt(strValue);
+    }
 
-    value = Utils::replace(value, "%BASE_MEDIA_PATH%", baseMediaPath);
-    value = Utils::replace(value, "%BASE_ITEM_PATH%", baseItemPath);
     return retVal;
 }
 
-bool Configuration::getProperty(std::string key, int &value)
+bool Configuration::getProperty(std::string key, bool &value)
 {
     std::string strValue;
 
@@ -252,15 +269,13 @@ bool Configuration::getProperty(std::string key, int &value)
 
     if(retVal)
     {
-        std::stringstream ss;
-        ss << strValue;
-        ss >> value;
+        value = toBool(strValue);
     }
 
     return retVal;
 }
 
-bool Configuration::getProperty(std::string key, bool &value)
+bool Configuration::getProperty(std::string key, float &value)
 {
     std::string strValue;
 
@@ -268,49 +283,223 @@ bool Configuration::getProperty(std::string key, bool &value)
 
     if(retVal)
     {
-        if(!strValue.compare("yes") || !strValue.compare("true"))
-        {
-            value = true;
-        }
-        else
-        {
-            value = false;
-        }
+        value = toFloat(strValue);
     }
 
     return retVal;
 }
 
+Configuration::Handle Configuration::getHandle(std::string key)
+{
+    Handle handle;
+
+    SDL_LockMutex(mutex_);
+    std::map<std::string, int>::iterator it = cacheSlots_.find(key);
+    if(it != cacheSlots_.end())
+    {
+        handle.slot_ = it->second;
+    }
+    else
+    {
+        CachedProperty property;
+        property.key        = key;
+        property.generation = -1;
+        property.exists     = false;
+        property.intValue   = 0;
+        property.boolValue  = false;
+        property.floatValue = 0;
+
+        handle.slot_ = (int)cache_.size();
+        cache_.push_back(property);
+        cacheSlots_[key] = handle.slot_;
+    }
+    SDL_UnlockMutex(mutex_);
+
+    return handle;
+}
+
+bool Configuration::getProperty(const Handle &handle, std::string &value)
+{
+    SDL_LockMutex(mutex_);
+    CachedProperty &property = resolve(handle);
+    bool retVal = property.exists;
+    value = (retVal) ? property.value : expand(value);
+    SDL_UnlockMutex(mutex_);
+
+    return retVal;
+}
+
+bool Configuration::getProperty(const Handle &handle, int &value)
+{
+    SDL_LockMutex(mutex_);
+    CachedProperty &property = resolve(handle);
+    bool retVal = property.exists;
+    if(retVal) value = property.intValue;
+    SDL_UnlockMutex(mutex_);
+
+    return retVal;
+}
+
+bool Configuration::getProperty(const Handle &handle, bool &value)
+{
+    SDL_LockMutex(mutex_);
+    CachedProperty &property = resolve(handle);
+    bool retVal = property.exists;
+    if(retVal) value = property.boolValue;
+    SDL_UnlockMutex(mutex_);
+
+    return retVal;
+}
+
+bool Configuration::getProperty(const Handle &handle, float &value)
+{
+    SDL_LockMutex(mutex_);
+    CachedProperty &property = resolve(handle);
+    bool retVal = property.exists;
+    if(retVal) value = property.floatValue;
+    SDL_UnlockMutex(mutex_);
+
+    return retVal;
+}
+
+bool Configuration::getPropertyAbsolutePath(const Handle &handle, std::string &value)
+{
+    SDL_LockMutex(mutex_);
+    CachedProperty &property = resolve(handle);
+    bool retVal = property.exists;
+    if(retVal) value = property.absoluteValue;
+    SDL_UnlockMutex(mutex_);
+
+    return retVal;
+}
+
+// mutex_ must be held
+Configuration::CachedProperty &Configuration::resolve(const Handle &handle)
+{
+    CachedProperty &property = cache_[handle.slot_];
+
+    if(property.generation != generation_)
+    {
+        PropertiesType::iterator it = properties_.find(property.key);
+
+        property.exists = (it != properties_.end());
+        property.value  = (property.exists) ? expand(it->second) : "";
+        property.absoluteValue = convertToAbsolutePath(absolutePath, property.value);
+        property.intValue   = toInt(property.value);
+        property.boolValue  = toBool(property.value);
+        property.floatValue = toFloat(property.value);
+        property.generation = generation_;
+    }
+
+    return property;
+}
+
+// mutex_ must be held
+std::string Configuration::expand(std::string value)
+{
+    if(value.find('%') == std::string::npos)
+    {
+        return value;
+    }
+
+    if(!basePathsValid_)
+    {
+        PropertiesType::iterator it;
+
+        it = properties_.find("baseMediaPath");
+        baseMediaPath_ = (it != properties_.end()) ? it->second : Utils::combinePath(absolutePath, "collections");
+        it = properties_.find("baseItemPath");
+        baseItemPath_  = (it != properties_.end()) ? it->second : Utils::combinePath(absolutePath, "collections");
+        basePathsValid_ = true;
+    }
+
+    value = Utils::replace(value, "%BASE_MEDIA_PATH%", baseMediaPath_);
+    value = Utils::replace(value, "%BASE_ITEM_PATH%", baseItemPath_);
+    return value;
+}
+
+// mutex_ must be held
+void Configuration::invalidate(const std::string &key)
+{
+    if(key == "baseMediaPath" || key == "baseItemPath")
+    {
+        // every expanded value may depend on these
+        generation_++;
+        basePathsValid_ = false;
+        return;
+    }
+
+    std::map<std::string, int>::iterator it = cacheSlots_.find(key);
+    if(it != cacheSlots_.end())
+    {
+        cache_[it->second].generation = -1;
+    }
+}
+
+int Configuration::toInt(const std::string &value)
+{
+    int intValue = 0;
+    std::stringstream ss;
+    ss << value;
+    ss >> intValue;
+    return intValue;
+}
+
+bool Configuration::toBool(const std::string &value)
+{
+    return (!value.compare("yes") || !value.compare("true"));
+}
+
+float Configuration::toFloat(const std::string &value)
+{
+    float floatValue = 0;
+    std::stringstream ss;
+    ss << value;
+    ss >> floatValue;
+    return floatValue;
+}
+
 void Configuration::setProperty(std::string key, std::string value)
 {
+    SDL_LockMutex(mutex_);
     properties_[key] = value;
+    invalidate(key);
+    SDL_UnlockMutex(mutex_);
 }
 
 bool Configuration::propertyExists(std::string key)
 {
-    return (properties_.find(key) != properties_.end());
+    SDL_LockMutex(mutex_);
+    bool exists = (properties_.find(key) != properties_.end());
+    SDL_UnlockMutex(mutex_);
+
+    return exists;
 }
 
 bool Configuration::propertyPrefixExists(std::string key)
 {
     PropertiesType::iterator it;
+    bool exists = false;
 
-    for(it = properties_.begin(); it != properties_.end(); ++it)
+    SDL_LockMutex(mutex_);
+    for(it = properties_.begin(); !exists && it != properties_.end(); ++it)
     {
         std::string search = key + ".";
         if(it->first.compare(0, search.length(), search) == 0)
         {
-            return true;
+            exists = true;
         }
     }
+    SDL_UnlockMutex(mutex_);
 
-    return false;
+    return exists;
 }
 
 void Configuration::childKeyCrumbs(std::string parent, std::vector<std::string> &children)
 {
     PropertiesType::iterator it;
 
+    SDL_LockMutex(mutex_);
     for(it = properties_.begin(); it != properties_.end(); ++it)
     {
         std::string search = parent + ".";
@@ -331,6 +520,7 @@ void Configuration::childKeyCrumbs(std::string parent, std::vector<std::string>
             }
         }
     }
+    SDL_UnlockMutex(mutex_);
 }
 
 std::string Configuration::convertToAbsolutePath(std::string prefix, std::string path)
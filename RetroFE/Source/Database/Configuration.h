@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <SDL2/SDL.h>
 #include <string>
 #include <map>
 #include <vector>
@@ -22,6 +23,18 @@
 class Configuration
 {
 public:
+    // A key looked up once. Reads through it reuse the expanded and parsed
+    // value until the property is set again, so keys that are read over and
+    // over cost a lock and a copy.
+    class Handle
+    {
+    public:
+        Handle() : slot_(-1) {}
+    private:
+        friend class Configuration;
+        int slot_;
+    };
+
     Configuration();
     virtual ~Configuration();
     static void initialize();
@@ -34,6 +47,13 @@ public:
     bool getProperty(std::string key, std::string &value);
     bool getProperty(std::string key, int &value);
     bool getProperty(std::string key, bool &value);
+    bool getProperty(std::string key, float &value);
+    Handle getHandle(std::string key);
+    bool getProperty(const Handle &handle, std::string &value);
+    bool getProperty(const Handle &handle, int &value);
+    bool getProperty(const Handle &handle, bool &value);
+    bool getProperty(const Handle &handle, float &value);
+    bool getPropertyAbsolutePath(const Handle &handle, std::string &value);
     void childKeyCrumbs(std::string parent, std::vector<std::string> &children);
     void setProperty(std::string key, std::string value);
     bool propertyExists(std::string key);
@@ -45,11 +65,42 @@ public:
     static std::string absolutePath;
 
 private:
-    bool getRawProperty(std::string key, std::string &value);
+    struct CachedProperty
+    {
+        std::string key;
+        int         generation; // current while equal to generation_
+        bool        exists;
+        std::string value;
+        std::string absoluteValue;
+        int         intValue;
+        bool        boolValue;
+        float       floatValue;
+    };
+
     bool parseLine(std::string collection, std::string keyPrefix, std::string line, int lineCount);
+    std::string expand(std::string value);
+    CachedProperty &resolve(const Handle &handle);
+    void invalidate(const std::string &key);
+    static int toInt(const std::string &value);
+    static bool toBool(const std::string &value);
+    static float toFloat(const std::string &value);
     typedef std::map<std::string, std::string> PropertiesType;
     typedef std::pair<std::string, std::string> PropertiesPair;
 
     PropertiesType properties_;
 
+    // handles index cache_; an entry is refreshed on its next read after
+    // its key is set, or after anything is when generation_ moves on
+    std::vector<CachedProperty> cache_;
+    std::map<std::string, int>  cacheSlots_;
+    int                         generation_;
+
+    // %BASE_MEDIA_PATH% and %BASE_ITEM_PATH%, resolved on first use
+    bool        basePathsValid_;
+    std::string baseMediaPath_;
+    std::string baseItemPath_;
+
+    // properties are read by the collection and initialization threads too
+    SDL_mutex *mutex_;
+
 };
@@ -0,0 +1,440 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MamelistReader.h"
+#include <cctype>
+#include <cstring>
+
+MamelistReader::MamelistReader()
+    : buffer_(64 * 1024)
+    , position_(0)
+    , length_(0)
+    , consumed_(0)
+    , size_(0)
+    , inList_(false)
+    , started_(false)
+    , error_(false)
+{
+}
+
+
+MamelistReader::~MamelistReader()
+{
+}
+
+
+bool MamelistReader::open(std::string filename)
+{
+    file_.open(filename.c_str(), std::ios::binary);
+    if(!file_.good())
+    {
+        return false;
+    }
+
+    file_.seekg(0, std::ios::end);
+    size_ = file_.tellg();
+    file_.seekg(0, std::ios::beg);
+
+    // the root is the first element; the xml declaration, comments and the
+    // DOCTYPE with its inline DTD come before it
+    Tag tag;
+    TagType type;
+    while((type = readTag(tag, NULL)) == TAG_OTHER);
+
+    inList_ = (type == TAG_START && tag.name == "mame");
+    return inList_;
+}
+
+
+bool MamelistReader::next(Machine &machine)
+{
+    Tag tag;
+    while(inList_)
+    {
+        TagType type = readTag(tag, NULL);
+
+        if(type == TAG_EOF || type == TAG_END)
+        {
+            // end of file, or </mame>
+            inList_ = false;
+        }
+        else if(type == TAG_START || type == TAG_EMPTY)
+        {
+            // the list starts at the first <machine> (or <game> in older lists);
+            // from there on every element is read as one
+            started_ = started_ || tag.name == "machine" || tag.name == "game";
+
+            bool named = tag.attribute("name", machine.name);
+            if(!readMachine(tag, machine))
+            {
+                error_  = true;
+                inList_ = false;
+            }
+            else if(named && started_)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+bool MamelistReader::error()
+{
+    return error_;
+}
+
+
+int MamelistReader::progress()
+{
+    if(size_ <= 0) return 100;
+    return static_cast<int>(consumed_ * 100 / size_);
+}
+
+
+// Mirrors what the DOM based importer read: the first <description>, <year>,
+// <manufacturer>, <genre> and <input> children, each element's first run of
+// text, and the name and cloneof attributes.
+bool MamelistReader::readMachine(Tag &machineTag, Machine &machine)
+{
+    bool hasDescription = false;
+    bool hasYear = false;
+    bool hasManufacturer = false;
+    bool hasGenre = false;
+    bool hasInput = false;
+
+    machine.description.clear();
+    machine.year.clear();
+    machine.manufacturer.clear();
+    machine.genre.clear();
+    machine.cloneOf.clear();
+    machine.players.clear();
+    machine.buttons.clear();
+    machineTag.attribute("cloneof", machine.cloneOf);
+
+    if(machineTag.type == TAG_EMPTY)
+    {
+        if(machine.description.empty()) machine.description = machine.name;
+        return true;
+    }
+
+    Tag tag;
+    std::string text;
+    std::string *capture = NULL;
+    int depth = 1;
+
+    while(depth > 0)
+    {
+        text.clear();
+        TagType type = readTag(tag, &text);
+
+        if(capture && depth == 2 && !text.empty())
+        {
+            decode(text);
+            *capture = text;
+            capture = NULL;
+        }
+
+        switch(type)
+        {
+        case TAG_EOF:
+            return false;
+
+        case TAG_END:
+            depth--;
+            if(depth == 1) capture = NULL;
+            break;
+
+        case TAG_START:
+        case TAG_EMPTY:
+            if(depth == 1)
+            {
+                std::string *field = NULL;
+                bool *seen = NULL;
+
+                if(tag.name == "description")       { field = &machine.description;  seen = &hasDescription; }
+                else if(tag.name == "year")         { field = &machine.year;         seen = &hasYear; }
+                else if(tag.name == "manufacturer") { field = &machine.manufacturer; seen = &hasManufacturer; }
+                else if(tag.name == "genre")        { field = &machine.genre;        seen = &hasGenre; }
+                else if(tag.name == "input" && !hasInput)
+                {
+                    hasInput = true;
+                    tag.attribute("players", machine.players);
+                    tag.attribute("buttons", machine.buttons);
+                }
+
+                if(seen && !*seen)
+                {
+                    *seen = true;
+                    if(type == TAG_START) capture = field;
+                }
+            }
+            if(type == TAG_START) depth++;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if(!hasDescription) machine.description = machine.name;
+
+    return true;
+}
+
+
+bool MamelistReader::Tag::attribute(const char *name, std::string &value)
+{
+    for(std::vector<std::pair<std::string, std::string> >::iterator it = attributes.begin(); it != attributes.end(); it++)
+    {
+        if(it->first == name)
+        {
+            value = it->second;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Reads up to and including the next markup. Character data before it is
+// appended to text (undecoded) when text is not NULL.
+MamelistReader::TagType MamelistReader::readTag(Tag &tag, std::string *text)
+{
+    int c;
+
+    tag.type = TAG_EOF;
+    tag.name.clear();
+    tag.attributes.clear();
+
+    while((c = get()) != '<')
+    {
+        if(c == EOF) return TAG_EOF;
+        if(text) text->push_back(static_cast<char>(c));
+    }
+
+    c = peek();
+    if(c == '!')
+    {
+        get();
+        if(peek() == '-')
+        {
+            if(!skipPast("-->")) return TAG_EOF;
+        }
+        else if(peek() == '[')
+        {
+            if(!skipPast("]]>")) return TAG_EOF;
+        }
+        else if(!skipDeclaration())
+        {
+            return TAG_EOF;
+        }
+        tag.type = TAG_OTHER;
+        return tag.type;
+    }
+    if(c == '?')
+    {
+        if(!skipPast("?>")) return TAG_EOF;
+        tag.type = TAG_OTHER;
+        return tag.type;
+    }
+
+    bool end = (c == '/');
+    if(end) get();
+
+    while((c = peek()) != EOF && !isspace(c) && c != '/' && c != '>')
+    {
+        tag.name.push_back(static_cast<char>(get()));
+    }
+
+    for(;;)
+    {
+        while((c = get()) != EOF && isspace(c));
+
+        if(c == EOF)
+        {
+            return TAG_EOF;
+        }
+        if(c == '>')
+        {
+            tag.type = end ? TAG_END : TAG_START;
+            return tag.type;
+        }
+        if(c == '/')
+        {
+            if(get() != '>') return TAG_EOF;
+            tag.type = TAG_EMPTY;
+            return tag.type;
+        }
+
+        std::string name(1, static_cast<char>(c));
+        while((c = peek()) != EOF && !isspace(c) && c != '=' && c != '>' && c != '/')
+        {
+            name.push_back(static_cast<char>(get()));
+        }
+        while((c = get()) != EOF && isspace(c));
+        if(c != '=') return TAG_EOF;
+        while((c = get()) != EOF && isspace(c));
+        if(c != '"' && c != '\'') return TAG_EOF;
+
+        int quote = c;
+        std::string value;
+        while((c = get()) != quote)
+        {
+            if(c == EOF) return TAG_EOF;
+            value.push_back(static_cast<char>(c));
+        }
+        decode(value);
+        tag.attributes.push_back(std::make_pair(name, value));
+    }
+}
+
+
+bool MamelistReader::skipPast(const char *terminator)
+{
+    size_t length = strlen(terminator);
+    std::string tail;
+    int c;
+
+    while((c = get()) != EOF)
+    {
+        tail.push_back(static_cast<char>(c));
+        if(tail.size() > length) tail.erase(0, 1);
+        if(tail == terminator) return true;
+    }
+    return false;
+}
+
+
+// <!DOCTYPE ...> and the like; the inline DTD may contain '>' inside [] and quotes.
+bool MamelistReader::skipDeclaration()
+{
+    int brackets = 0;
+    int quote = 0;
+    int c;
+
+    while((c = get()) != EOF)
+    {
+        if(quote)
+        {
+            if(c == quote) quote = 0;
+        }
+        else if(c == '"' || c == '\'') quote = c;
+        else if(c == '[') brackets++;
+        else if(c == ']') brackets--;
+        else if(c == '>' && brackets <= 0) return true;
+    }
+    return false;
+}
+
+
+int MamelistReader::get()
+{
+    if(position_ >= length_ && !fill()) return EOF;
+    consumed_++;
+    return static_cast<unsigned char>(buffer_[position_++]);
+}
+
+
+int MamelistReader::peek()
+{
+    if(position_ >= length_ && !fill()) return EOF;
+    return static_cast<unsigned char>(buffer_[position_]);
+}
+
+
+bool MamelistReader::fill()
+{
+    if(!file_.good()) return false;
+    file_.read(&buffer_[0], buffer_.size());
+    length_   = static_cast<size_t>(file_.gcount());
+    position_ = 0;
+    return length_ > 0;
+}
+
+
+// Expands the predefined entities and character references the same way
+// the previous rapidxml based importer did; unknown entities stay as written.
+void MamelistReader::decode(std::string &str)
+{
+    size_t amp = str.find('&');
+    if(amp == std::string::npos) return;
+
+    std::string out(str, 0, amp);
+    size_t i = amp;
+
+    while(i < str.size())
+    {
+        if(str[i] != '&')
+        {
+            out.push_back(str[i++]);
+            continue;
+        }
+
+        if(str.compare(i, 5, "&amp;") == 0)       { out.push_back('&');  i += 5; }
+        else if(str.compare(i, 4, "&lt;") == 0)   { out.push_back('<');  i += 4; }
+        else if(str.compare(i, 4, "&gt;") == 0)   { out.push_back('>');  i += 4; }
+        else if(str.compare(i, 6, "&quot;") == 0) { out.push_back('"');  i += 6; }
+        else if(str.compare(i, 6, "&apos;") == 0) { out.push_back('\''); i += 6; }
+        else if(i + 1 < str.size() && str[i + 1] == '#')
+        {
+            bool hex = (i + 2 < str.size() && str[i + 2] == 'x');
+            unsigned long code = 0;
+            i += hex ? 3 : 2;
+            while(i < str.size() && (hex ? isxdigit((unsigned char)str[i]) : isdigit((unsigned char)str[i])))
+            {
+                char c = str[i++];
+                code = code * (hex ? 16 : 10) + (isdigit((unsigned char)c) ? c - '0' : (tolower((unsigned char)c) - 'a' + 10));
+            }
+            appendUtf8(out, code);
+            if(i < str.size() && str[i] == ';') i++;
+        }
+        else
+        {
+            out.push_back(str[i++]);
+        }
+    }
+
+    str.swap(out);
+}
+
+
+void MamelistReader::appendUtf8(std::string &str, unsigned long code)
+{
+    if(code < 0x80)
+    {
+        str.push_back(static_cast<char>(code));
+    }
+    else if(code < 0x800)
+    {
+        str.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        str.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else if(code < 0x10000)
+    {
+        str.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        str.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        str.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else
+    {
+        str.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        str.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        str.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        str.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
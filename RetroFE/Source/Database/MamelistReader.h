@@ -0,0 +1,93 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Reads a MAME -listxml file one <machine> (or <game>) element at a time,
+// so memory use does not grow with the size of the file. Only the fields
+// MetadataDatabase stores are kept; everything else is skipped as it is read.
+class MamelistReader
+{
+public:
+    struct Machine
+    {
+        std::string name;
+        std::string description;
+        std::string year;
+        std::string manufacturer;
+        std::string genre;
+        std::string cloneOf;
+        std::string players;
+        std::string buttons;
+    };
+
+    MamelistReader();
+    virtual ~MamelistReader();
+
+    // Opens the file and moves past the <mame> start tag. Returns false if
+    // the file can not be read or has no <mame> root element.
+    bool open(std::string filename);
+
+    // Reads the next machine that has a name. Returns false at the end of
+    // the list or when the file is malformed; see error().
+    bool next(Machine &machine);
+
+    bool error();
+
+    // Percentage of the file read so far.
+    int progress();
+
+private:
+    enum TagType
+    {
+        TAG_START,
+        TAG_END,
+        TAG_EMPTY,
+        TAG_OTHER,
+        TAG_EOF
+    };
+
+    struct Tag
+    {
+        TagType type;
+        std::string name;
+        std::vector<std::pair<std::string, std::string> > attributes;
+        bool attribute(const char *name, std::string &value);
+    };
+
+    bool readMachine(Tag &machineTag, Machine &machine);
+    TagType readTag(Tag &tag, std::string *text);
+    bool skipPast(const char *terminator);
+    bool skipDeclaration();
+    int get();
+    int peek();
+    bool fill();
+    static void decode(std::string &str);
+    static void appendUtf8(std::string &str, unsigned long code);
+
+    std::ifstream     file_;
+    std::vector<char> buffer_;
+    size_t            position_;
+    size_t            length_;
+    long long         consumed_;
+    long long         size_;
+    bool              inList_;
+    bool              started_;
+    bool              error_;
+};
@@ -20,6 +20,8 @@
 #include "../Utility/Utils.h"
 #include "Configuration.h"
 #include "DB.h"
+#include "MamelistReader.h"
+#include "MetadataWriter.h"
 #include <algorithm>
 #include <dirent.h>
 #include <fstream>
@@ -58,6 +60,7 @@ bool MetadataDatabase::resetDatabase()
 
     std::string sql;
     sql.append("DROP TABLE IF EXISTS Meta;");
+    sql.append("DROP TABLE IF EXISTS MetaFiles;");
 
     rc = sqlite3_exec(handle, sql.c_str(), NULL, 0, &error);
 
@@ -73,11 +76,54 @@ bool MetadataDatabase::resetDatabase()
 }
 
 bool MetadataDatabase::initialize()
+{
+    sqlite3 *handle = db_.handle;
+
+    if(!createTables())
+    {
+        return false;
+    }
+
+    if(needsRebuild())
+    {
+        Logger::write(Logger::ZONE_INFO, "Metadata", "Rebuilding metadata");
+        sqlite3_exec(handle, "DELETE FROM Meta; DELETE FROM MetaFiles;", NULL, NULL, NULL);
+    }
+
+    // a manifest that can not be read or kept up to date (e.g. MetaFiles
+    // from another version) would leave stale rows behind; start over
+    if(!importDirectory())
+    {
+        Logger::write(Logger::ZONE_WARNING, "Metadata", "Could not update the metadata manifest; rebuilding metadata");
+        sqlite3_exec(handle, "DROP TABLE IF EXISTS Meta; DROP TABLE IF EXISTS MetaFiles;", NULL, NULL, NULL);
+
+        if(!createTables())
+        {
+            return false;
+        }
+        importDirectory();
+    }
+
+    return true;
+}
+
+bool MetadataDatabase::createTables()
 {
     int rc;
     char *error = NULL;
     sqlite3 *handle = db_.handle;
 
+    // tables from before the file manifest can not be updated in place
+    sqlite3_stmt *stmt;
+    if(sqlite3_prepare_v2(handle, "SELECT fileId FROM Meta LIMIT 0;", -1, &stmt, 0) == SQLITE_OK)
+    {
+        sqlite3_finalize(stmt);
+    }
+    else
+    {
+        sqlite3_exec(handle, "DROP TABLE IF EXISTS Meta;", NULL, NULL, NULL);
+    }
+
     std::string sql;
     sql.append("CREATE TABLE IF NOT EXISTS Meta(");
     sql.append("collectionName TEXT KEY,");
@@ -93,8 +139,24 @@ bool MetadataDatabase::initialize()
     sql.append("buttons TEXT NOT NULL DEFAULT '',");
     sql.append("joyways TEXT NOT NULL DEFAULT '',");
     sql.append("rating TEXT NOT NULL DEFAULT '',");
-    sql.append("score TEXT NOT NULL DEFAULT '');");
-    sql.append("CREATE UNIQUE INDEX IF NOT EXISTS MetaUniqueId ON Meta(collectionName, name);");
+    sql.append("score TEXT NOT NULL DEFAULT '',");
+    sql.append("fileId INTEGER NOT NULL DEFAULT 0);");
+    // A bulk import that was interrupted before endBulkImport leaves Meta
+    // without its unique index and possibly with duplicate rows, which would
+    // make creating the index fail; remove them the way endBulkImport does.
+    if(!hasIndex("MetaUniqueId"))
+    {
+        sql.append("DELETE FROM Meta WHERE collectionName IS NOT NULL AND rowid NOT IN (SELECT MAX(rowid) FROM Meta GROUP BY collectionName, name, fileId);");
+    }
+    sql.append("CREATE UNIQUE INDEX IF NOT EXISTS MetaUniqueId ON Meta(collectionName, name, fileId);");
+    sql.append("CREATE INDEX IF NOT EXISTS MetaFileId ON Meta(fileId);");
+    sql.append("CREATE TABLE IF NOT EXISTS MetaFiles(");
+    sql.append("id INTEGER PRIMARY KEY,");
+    sql.append("path TEXT NOT NULL UNIQUE,");
+    sql.append("size INTEGER NOT NULL DEFAULT -1,");
+    sql.append("mtime INTEGER NOT NULL DEFAULT 0,");
+    sql.append("hash INTEGER NOT NULL DEFAULT 0,");
+    sql.append("rank INTEGER NOT NULL DEFAULT 0);");
 
     rc = sqlite3_exec(handle, sql.c_str(), NULL, 0, &error);
 
@@ -107,119 +169,681 @@ bool MetadataDatabase::initialize()
         return false;
     }
 
-    if(needsRefresh())
+    return true;
+}
+
+bool MetadataDatabase::hasIndex(std::string name)
+{
+    bool found = false;
+    sqlite3_stmt *stmt;
+
+    if(sqlite3_prepare_v2(db_.handle, "SELECT 1 FROM sqlite_master WHERE type = 'index' AND name = ?;", -1, &stmt, 0) == SQLITE_OK)
     {
-        importDirectory();
+        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+        found = (sqlite3_step(stmt) == SQLITE_ROW);
+        sqlite3_finalize(stmt);
     }
 
-    return true;
+    return found;
 }
 
-bool MetadataDatabase::importDirectory()
+// Import-time settings: no fsync, journal in memory and a larger page cache.
+// When Meta starts out empty the indexes are dropped while the lists are
+// loaded and rebuilt once at the end; see endBulkImport.
+void MetadataDatabase::beginBulkImport(BulkImport &bulk)
 {
-    DIR *dp;
-    struct dirent *dirp;
-    std::string hyperListPath  = Utils::combinePath(Configuration::absolutePath, "meta", "hyperlist");
-    std::string mameListPath   = Utils::combinePath(Configuration::absolutePath, "meta", "mamelist");
-    std::string emuarcListPath = Utils::combinePath(Configuration::absolutePath, "meta", "emuarc");
+    sqlite3 *handle = db_.handle;
 
-    dp = opendir(hyperListPath.c_str());
+    bulk.synchronous = pragmaValue("synchronous");
+    bulk.journalMode = pragmaValue("journal_mode");
+    bulk.cacheSize   = pragmaValue("cache_size");
 
-    if(dp == NULL)
+    sqlite3_exec(handle,
+                 "PRAGMA synchronous = OFF;"
+                 "PRAGMA journal_mode = MEMORY;"
+                 "PRAGMA cache_size = -65536;",
+                 NULL, NULL, NULL);
+
+    if(bulk.dropIndexes)
     {
-        Logger::write(Logger::ZONE_INFO, "MetadataDatabase", "Could not read directory \"" + hyperListPath + "\"");
+        sqlite3_exec(handle,
+                     "DROP INDEX IF EXISTS MetaUniqueId;"
+                     "DROP INDEX IF EXISTS MetaFileId;",
+                     NULL, NULL, NULL);
     }
-    else
+}
+
+
+// Without the index INSERT OR REPLACE can not replace, so duplicates are
+// removed here the way it would have: the last row a file wrote for a
+// (collectionName, name) pair wins.
+void MetadataDatabase::endBulkImport(BulkImport &bulk)
+{
+    char *error = NULL;
+    sqlite3 *handle = db_.handle;
+
+    if(bulk.dropIndexes)
     {
-        while((dirp = readdir(dp)) != NULL)
+        config_.setProperty("status", "Indexing metadata");
+
+        std::string sql;
+        sql.append("BEGIN IMMEDIATE TRANSACTION;");
+        sql.append("DELETE FROM Meta WHERE collectionName IS NOT NULL AND rowid NOT IN (SELECT MAX(rowid) FROM Meta GROUP BY collectionName, name, fileId);");
+        sql.append("CREATE UNIQUE INDEX IF NOT EXISTS MetaUniqueId ON Meta(collectionName, name, fileId);");
+        sql.append("CREATE INDEX IF NOT EXISTS MetaFileId ON Meta(fileId);");
+        sql.append("COMMIT TRANSACTION;");
+
+        if(sqlite3_exec(handle, sql.c_str(), NULL, NULL, &error) != SQLITE_OK)
         {
-            if (dirp->d_type != DT_DIR && std::string(dirp->d_name) != "." && std::string(dirp->d_name) != "..")
-            {
+            std::string emsg = (error) ? error : "";
+            sqlite3_free(error);
+            Logger::write(Logger::ZONE_ERROR, "Metadata", "SQL Error rebuilding the metadata index: " + emsg);
+            sqlite3_exec(handle, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+        }
+    }
 
-                std::string basename = dirp->d_name;
+    if(!bulk.synchronous.empty())
+        sqlite3_exec(handle, ("PRAGMA synchronous = " + bulk.synchronous + ";").c_str(), NULL, NULL, NULL);
+    if(!bulk.journalMode.empty())
+        sqlite3_exec(handle, ("PRAGMA journal_mode = " + bulk.journalMode + ";").c_str(), NULL, NULL, NULL);
+    if(!bulk.cacheSize.empty())
+        sqlite3_exec(handle, ("PRAGMA cache_size = " + bulk.cacheSize + ";").c_str(), NULL, NULL, NULL);
+}
 
-                std::string extension = basename.substr(basename.find_last_of("."), basename.size()-1);
-                basename = basename.substr(0, basename.find_last_of("."));
-                std::string collectionName = basename.substr(0, basename.find_first_of("."));
 
+std::string MetadataDatabase::pragmaValue(std::string name)
+{
+    sqlite3_stmt *stmt;
+    std::string value;
 
-                if(extension == ".xml")
-                {
-                    std::string importFile = Utils::combinePath(hyperListPath, std::string(dirp->d_name));
-                    Logger::write(Logger::ZONE_INFO, "Metadata", "Importing hyperlist: " + importFile);
-                    importHyperlist(importFile, collectionName);
-                }
-            }
+    if(sqlite3_prepare_v2(db_.handle, ("PRAGMA " + name + ";").c_str(), -1, &stmt, 0) == SQLITE_OK)
+    {
+        if(sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_text(stmt, 0))
+        {
+            value = (char *)sqlite3_column_text(stmt, 0);
         }
+        sqlite3_finalize(stmt);
+    }
+
+    return value;
+}
+
 
-        if (dp) closedir(dp);
+// Parses one list on a worker thread. The importer writes to it as it would
+// to the database; rows are passed on in batches to the writer thread, and
+// the parser waits while too many batches are pending. A list whose
+// contents match the manifest is not parsed at all.
+class MetadataDatabase::ImportJob : public WorkQueue::Job, public MetadataWriter
+{
+public:
+    ImportJob(MetadataDatabase &mdb, ImportQueue &queue, ListFile &list, ManifestEntry &entry, long long size, long long mtime)
+        : MetadataWriter(queue.db)
+        , done(false)
+        , unchanged(false)
+        , fileId(entry.id)
+        , purge(entry.size >= 0)
+        , mdb_(mdb)
+        , queue_(queue)
+        , list_(list)
+        , size_(size)
+        , mtime_(mtime)
+        , hash_(0)
+        , oldHash_((entry.size >= 0) ? entry.hash : -1)
+        , batch_(NULL)
+    {
     }
 
-    dp = opendir(mameListPath.c_str());
+    ~ImportJob()
+    {
+        delete batch_;
+        while(!batches.empty())
+        {
+            delete batches.front();
+            batches.pop_front();
+        }
+    }
 
-    if(dp == NULL)
+    void run()
     {
-        Logger::write(Logger::ZONE_INFO, "CollectionInfoBuilder", "Could not read directory \"" + mameListPath + "\"");
+        hash_ = hashFile(list_.path);
+        unchanged = (hash_ == oldHash_);
+
+        if(!unchanged)
+        {
+            import(*this);
+        }
+        commit();
     }
-    else
+
+    void import(MetadataWriter &writer)
     {
-        while((dirp = readdir(dp)) != NULL)
+        switch(list_.type)
         {
-            if (dirp->d_type != DT_DIR && std::string(dirp->d_name) != "." && std::string(dirp->d_name) != "..")
-            {
+        case HYPERLIST:  mdb_.importHyperlist(list_.path, list_.collectionName, writer); break;
+        case MAMELIST:   mdb_.importMamelist(list_.path, list_.collectionName, writer); break;
+        case EMUARCLIST: mdb_.importEmuArclist(list_.path, writer); break;
+        }
+    }
 
-                std::string basename = dirp->d_name;
+    bool begin(const char *sql)
+    {
+        insertSql = sql;
+        return true;
+    }
 
-                std::string extension = basename.substr(basename.find_last_of("."), basename.size()-1);
-                basename = basename.substr(0, basename.find_last_of("."));
-                std::string collectionName = basename.substr(0, basename.find_first_of("."));
+    void bind(int parameter, const std::string &value)
+    {
+        if(row_.size() < (unsigned int)parameter) row_.resize(parameter);
+        row_[parameter - 1] = value;
+    }
 
+    bool insert()
+    {
+        if(!batch_) batch_ = new Batch();
+        batch_->push_back(row_);
+        row_.clear();
 
-                if(extension == ".xml")
-                {
-                    std::string importFile = Utils::combinePath(mameListPath, std::string(dirp->d_name));
-                    Logger::write(Logger::ZONE_INFO, "Metadata", "Importing mamelist: " + importFile);
-                    config_.setProperty("status", "Scraping data from " + importFile);
-                    importMamelist(importFile, collectionName);
-                }
+        if(batch_->size() >= batchSize) push();
+        return true;
+    }
+
+    bool commit()
+    {
+        if(batch_) push();
+
+        SDL_LockMutex(queue_.mutex);
+        done = true;
+        SDL_CondBroadcast(queue_.cond);
+        SDL_UnlockMutex(queue_.mutex);
+        return true;
+    }
+
+    std::string error()
+    {
+        return "";
+    }
+
+    // Drops the rows the previous import of this list left behind.
+    bool purgeRows(sqlite3 *handle)
+    {
+        if(!purge) return true;
+
+        sqlite3_stmt *stmt;
+        if(sqlite3_prepare_v2(handle, "DELETE FROM Meta WHERE fileId = ?;", -1, &stmt, 0) != SQLITE_OK)
+        {
+            Logger::write(Logger::ZONE_ERROR, "Metadata", "Could not remove old metadata of " + list_.path + ": " + std::string(sqlite3_errmsg(handle)));
+            return false;
+        }
+        sqlite3_bind_int64(stmt, 1, fileId);
+        sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        return true;
+    }
+
+    // Remembers what was imported; done in the same transaction as the rows.
+    bool record(sqlite3 *handle)
+    {
+        sqlite3_stmt *stmt;
+        if(sqlite3_prepare_v2(handle, "UPDATE MetaFiles SET size = ?, mtime = ?, hash = ? WHERE id = ?;", -1, &stmt, 0) != SQLITE_OK)
+        {
+            Logger::write(Logger::ZONE_ERROR, "Metadata", "Could not record " + list_.path + " in the metadata manifest: " + std::string(sqlite3_errmsg(handle)));
+            return false;
+        }
+        sqlite3_bind_int64(stmt, 1, size_);
+        sqlite3_bind_int64(stmt, 2, mtime_);
+        sqlite3_bind_int64(stmt, 3, hash_);
+        sqlite3_bind_int64(stmt, 4, fileId);
+        sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        return true;
+    }
+
+    // read by the writer thread under queue.mutex
+    std::string        insertSql;
+    std::list<Batch *> batches;
+    bool               done;
+    bool               unchanged;
+    long long          fileId;
+    bool               purge;
+
+private:
+    static const unsigned int batchSize  = 512;
+    static const unsigned int maxBatches = 8;
+
+    void push()
+    {
+        SDL_LockMutex(queue_.mutex);
+        while(batches.size() >= maxBatches)
+        {
+            SDL_CondWait(queue_.cond, queue_.mutex);
+        }
+        batches.push_back(batch_);
+        SDL_CondBroadcast(queue_.cond);
+        SDL_UnlockMutex(queue_.mutex);
+        batch_ = NULL;
+    }
+
+    static long long hashFile(std::string path)
+    {
+        std::ifstream file(path.c_str(), std::ios::binary);
+        std::vector<char> buffer(65536);
+        uLong crc = crc32(0L, Z_NULL, 0);
+
+        while(file.read(&buffer[0], buffer.size()) || file.gcount() > 0)
+        {
+            crc = crc32(crc, (const Bytef *)&buffer[0], (uInt)file.gcount());
+        }
+
+        return (long long)crc;
+    }
+
+    MetadataDatabase        &mdb_;
+    ImportQueue             &queue_;
+    ListFile                 list_;
+    long long                size_;
+    long long                mtime_;
+    long long                hash_;
+    long long                oldHash_;
+    Batch                   *batch_;
+    std::vector<std::string> row_;
+};
+
+
+MetadataDatabase::ImportQueue::ImportQueue(DB &db)
+    : db(db)
+    , mutex(SDL_CreateMutex())
+    , cond(SDL_CreateCond())
+    , failed(false)
+{
+}
+
+
+MetadataDatabase::ImportQueue::~ImportQueue()
+{
+    SDL_DestroyCond(cond);
+    SDL_DestroyMutex(mutex);
+}
+
+
+// Compares the lists under meta/ with the manifest of what was imported
+// last time. Only lists that were added or changed are read again, and the
+// rows of lists that are gone are dropped.
+bool MetadataDatabase::importDirectory()
+{
+    sqlite3 *handle = db_.handle;
+    std::string metaPath = Utils::combinePath(Configuration::absolutePath, "meta");
+    std::vector<ListFile> lists;
+    Manifest manifest;
+
+    findLists(metaPath, "hyperlist", ".xml", HYPERLIST, lists);
+    findLists(metaPath, "mamelist", ".xml", MAMELIST, lists);
+    findLists(metaPath, "emuarc", ".dat", EMUARCLIST, lists);
+
+    if(!readManifest(manifest))
+    {
+        return false;
+    }
+
+    ImportQueue queue(db_);
+    std::vector<WorkQueue::Job *> jobs;
+    BulkImport bulk;
+    bool ok = true;
+    bulk.dropIndexes = manifest.empty();
+
+    sqlite3_exec(handle, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, NULL);
+
+    for(unsigned int i = 0; i < lists.size(); ++i)
+    {
+        ListFile &list = lists[i];
+        struct stat sb;
+
+        if(stat(list.path.c_str(), &sb) != 0)
+        {
+            continue;
+        }
+
+        Manifest::iterator it = manifest.find(list.name);
+        if(it == manifest.end())
+        {
+            ManifestEntry entry;
+            entry.id    = addToManifest(list.name);
+            entry.size  = -1;
+            entry.mtime = 0;
+            entry.hash  = 0;
+            entry.rank  = -1;
+            entry.seen  = false;
+            if(entry.id < 0)
+            {
+                ok = false;
+                break;
             }
+            it = manifest.insert(Manifest::value_type(list.name, entry)).first;
         }
 
-        if (dp) closedir(dp);
+        ManifestEntry &entry = it->second;
+        entry.seen = true;
+
+        // the order lists are found in decides which wins for a game listed twice
+        if(entry.rank != (int)i && !setManifestRank(entry.id, i))
+        {
+            ok = false;
+            break;
+        }
+
+        if(entry.size != (long long)sb.st_size || entry.mtime != (long long)sb.st_mtime)
+        {
+            Logger::write(Logger::ZONE_INFO, "Metadata", "Importing " + list.path);
+            jobs.push_back(new ImportJob(*this, queue, list, entry, sb.st_size, sb.st_mtime));
+        }
     }
 
-    dp = opendir(emuarcListPath.c_str());
+    for(Manifest::iterator it = manifest.begin(); ok && it != manifest.end(); it++)
+    {
+        if(!it->second.seen)
+        {
+            Logger::write(Logger::ZONE_INFO, "Metadata", "Removing metadata from " + Utils::combinePath(metaPath, it->first));
+            ok = removeFromManifest(it->second.id);
+        }
+    }
+
+    if(!ok)
+    {
+        sqlite3_exec(handle, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+        for(unsigned int i = 0; i < jobs.size(); ++i)
+        {
+            delete jobs[i];
+        }
+        return false;
+    }
+
+    sqlite3_exec(handle, "COMMIT TRANSACTION;", NULL, NULL, NULL);
+
+    if(!jobs.empty())
+    {
+        beginBulkImport(bulk);
+        ok = runImports(queue, jobs);
+        endBulkImport(bulk);
+    }
+
+    return ok;
+}
+
+
+// Lists of one kind in a directory, sorted by file name so their order, and
+// with it which list wins for a game listed twice, does not depend on the
+// file system.
+void MetadataDatabase::findLists(std::string metaPath, std::string dir, std::string extension, ListType type, std::vector<ListFile> &lists)
+{
+    DIR *dp;
+    struct dirent *dirp;
+    std::vector<std::string> names;
+    std::string path = Utils::combinePath(metaPath, dir);
+
+    dp = opendir(path.c_str());
 
     if(dp == NULL)
     {
-        Logger::write(Logger::ZONE_INFO, "MetadataDatabase", "Could not read directory \"" + emuarcListPath + "\"");
+        Logger::write(Logger::ZONE_INFO, "MetadataDatabase", "Could not read directory \"" + path + "\"");
+        return;
+    }
+
+    while((dirp = readdir(dp)) != NULL)
+    {
+        std::string basename = dirp->d_name;
+        size_t dot = basename.find_last_of(".");
+
+        if(dirp->d_type != DT_DIR && dot != std::string::npos && basename.substr(dot) == extension)
+        {
+            names.push_back(basename);
+        }
+    }
+
+    closedir(dp);
+
+    std::sort(names.begin(), names.end());
+
+    for(std::vector<std::string>::iterator it = names.begin(); it != names.end(); it++)
+    {
+        ListFile list;
+        list.type = type;
+        list.name = Utils::combinePath(dir, *it);
+        list.path = Utils::combinePath(path, *it);
+        if(type != EMUARCLIST)
+        {
+            list.collectionName = it->substr(0, it->find_first_of("."));
+        }
+        lists.push_back(list);
+    }
+}
+
+
+bool MetadataDatabase::readManifest(Manifest &manifest)
+{
+    sqlite3_stmt *stmt;
+
+    if(sqlite3_prepare_v2(db_.handle, "SELECT id, path, size, mtime, hash, rank FROM MetaFiles;", -1, &stmt, 0) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Metadata", "Could not read the metadata manifest: " + std::string(sqlite3_errmsg(db_.handle)));
+        return false;
+    }
+
+    while(sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        ManifestEntry entry;
+        entry.id    = sqlite3_column_int64(stmt, 0);
+        entry.size  = sqlite3_column_int64(stmt, 2);
+        entry.mtime = sqlite3_column_int64(stmt, 3);
+        entry.hash  = sqlite3_column_int64(stmt, 4);
+        entry.rank  = sqlite3_column_int(stmt, 5);
+        entry.seen  = false;
+        manifest[(char *)sqlite3_column_text(stmt, 1)] = entry;
+    }
+
+    sqlite3_finalize(stmt);
+
+    return true;
+}
+
+
+// New lists get an entry before they are read, so their rows have an id
+// to carry. The size stays unknown until the rows are in.
+long long MetadataDatabase::addToManifest(std::string path)
+{
+    sqlite3_stmt *stmt;
+    long long id = -1;
+
+    if(sqlite3_prepare_v2(db_.handle, "INSERT INTO MetaFiles (path) VALUES (?);", -1, &stmt, 0) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Metadata", "Could not add \"" + path + "\" to the metadata manifest: " + std::string(sqlite3_errmsg(db_.handle)));
+        return id;
+    }
+    sqlite3_bind_text(stmt, 1, path.c_str(), -1, SQLITE_TRANSIENT);
+
+    if(sqlite3_step(stmt) == SQLITE_DONE)
+    {
+        id = sqlite3_last_insert_rowid(db_.handle);
+    }
+    else
+    {
+        Logger::write(Logger::ZONE_ERROR, "Metadata", "Could not add \"" + path + "\" to the metadata manifest: " + std::string(sqlite3_errmsg(db_.handle)));
+    }
+
+    sqlite3_finalize(stmt);
+
+    return id;
+}
+
+
+bool MetadataDatabase::setManifestRank(long long id, int rank)
+{
+    sqlite3_stmt *stmt;
+
+    if(sqlite3_prepare_v2(db_.handle, "UPDATE MetaFiles SET rank = ? WHERE id = ?;", -1, &stmt, 0) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Metadata", "Could not update the metadata manifest: " + std::string(sqlite3_errmsg(db_.handle)));
+        return false;
+    }
+    sqlite3_bind_int(stmt, 1, rank);
+    sqlite3_bind_int64(stmt, 2, id);
+    sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+
+    return true;
+}
+
+
+bool MetadataDatabase::removeFromManifest(long long id)
+{
+    sqlite3_stmt *stmt;
+
+    if(sqlite3_prepare_v2(db_.handle, "DELETE FROM Meta WHERE fileId = ?;", -1, &stmt, 0) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Metadata", "Could not remove metadata: " + std::string(sqlite3_errmsg(db_.handle)));
+        return false;
+    }
+    sqlite3_bind_int64(stmt, 1, id);
+    sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+
+    if(sqlite3_prepare_v2(db_.handle, "DELETE FROM MetaFiles WHERE id = ?;", -1, &stmt, 0) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Metadata", "Could not update the metadata manifest: " + std::string(sqlite3_errmsg(db_.handle)));
+        return false;
+    }
+    sqlite3_bind_int64(stmt, 1, id);
+    sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+
+    return true;
+}
+
+
+// Lists are parsed side by side, but written one after another in the order
+// they were found, so a name listed in several files ends up with the same
+// row as when they were imported one by one.
+bool MetadataDatabase::runImports(ImportQueue &queue, std::vector<WorkQueue::Job *> &jobs)
+{
+    if(jobs.empty()) return true;
+
+    for(unsigned int i = 0; i < jobs.size(); ++i)
+    {
+        queue.jobs.push_back(static_cast<ImportJob *>(jobs[i]));
+    }
+
+    int threads = 0;
+    (void)config_.getProperty("metadataImportThreads", threads);
+    if(threads <= 0) threads = SDL_GetCPUCount();
+
+    SDL_Thread *writer = SDL_CreateThread(writeImports, "MetadataWriter", (void *)&queue);
+    if(writer)
+    {
+        WorkQueue::run(jobs, threads);
+        SDL_WaitThread(writer, NULL);
     }
     else
     {
-        while((dirp = readdir(dp)) != NULL)
+        // nobody to hand rows to; import directly
+        for(unsigned int i = 0; i < queue.jobs.size(); ++i)
         {
-            if (dirp->d_type != DT_DIR && std::string(dirp->d_name) != "." && std::string(dirp->d_name) != "..")
+            ImportJob *job = queue.jobs[i];
+            if(!job->purgeRows(db_.handle))
             {
+                queue.failed = true;
+                break;
+            }
+            {
+                MetadataWriter direct(db_, job->fileId);
+                job->import(direct);
+            }
+            if(!job->record(db_.handle))
+            {
+                queue.failed = true;
+                break;
+            }
+        }
+    }
 
-                std::string basename = dirp->d_name;
+    for(unsigned int i = 0; i < jobs.size(); ++i)
+    {
+        delete jobs[i];
+    }
 
-                std::string extension = basename.substr(basename.find_last_of("."), basename.size()-1);
-                basename = basename.substr(0, basename.find_last_of("."));
+    return !queue.failed;
+}
 
 
-                if(extension == ".dat")
+int MetadataDatabase::writeImports(void *context)
+{
+    ImportQueue *queue = static_cast<ImportQueue *>(context);
+    sqlite3 *handle = queue->db.handle;
+
+    for(unsigned int i = 0; i < queue->jobs.size(); ++i)
+    {
+        ImportJob *job = queue->jobs[i];
+        MetadataWriter writer(queue->db, job->fileId);
+        bool started = false;
+        bool ok = false;
+
+        for(;;)
+        {
+            SDL_LockMutex(queue->mutex);
+            while(job->batches.empty() && !job->done)
+            {
+                SDL_CondWait(queue->cond, queue->mutex);
+            }
+            if(job->batches.empty())
+            {
+                SDL_UnlockMutex(queue->mutex);
+                break;
+            }
+            Batch *batch = job->batches.front();
+            job->batches.pop_front();
+            SDL_CondBroadcast(queue->cond);
+            SDL_UnlockMutex(queue->mutex);
+
+            if(!started)
+            {
+                started = true;
+                ok = writer.begin(job->insertSql.c_str());
+                if(ok && !job->purgeRows(handle))
                 {
-                    std::string importFile = Utils::combinePath(emuarcListPath, std::string(dirp->d_name));
-                    Logger::write(Logger::ZONE_INFO, "Metadata", "Importing emuarclist: " + importFile);
-                    importEmuArclist(importFile);
+                    queue->failed = true;
+                    ok = false;
                 }
             }
+
+            for(Batch::iterator row = batch->begin(); ok && row != batch->end(); row++)
+            {
+                for(unsigned int c = 0; c < row->size(); ++c)
+                {
+                    writer.bind(c + 1, (*row)[c]);
+                }
+                if(!writer.insert())
+                {
+                    Logger::write(Logger::ZONE_ERROR, "Metadata", "Failed to insert \"" + row->front() + "\" into database; " + writer.error());
+                }
+            }
+            delete batch;
         }
 
-        if (dp) closedir(dp);
+        if(ok)
+        {
+            if(!job->record(handle)) queue->failed = true;
+            writer.commit();
+        }
+        else if(!started)
+        {
+            // nothing to write: the list is unchanged, empty or unreadable
+            sqlite3_exec(handle, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, NULL);
+            if((!job->unchanged && !job->purgeRows(handle)) || !job->record(handle))
+            {
+                queue->failed = true;
+            }
+            sqlite3_exec(handle, "COMMIT TRANSACTION;", NULL, NULL, NULL);
+        }
     }
 
-    return true;
+    return 0;
 }
 
 void MetadataDatabase::injectMetadata(CollectionInfo *collection)
@@ -239,14 +863,15 @@ void MetadataDatabase::injectMetadata(CollectionInfo *collection)
 
     //todo: program crashes if this query fails
     sqlite3_prepare_v2(handle,
-                       "SELECT DISTINCT Meta.name, Meta.title, Meta.year, Meta.manufacturer, Meta.developer, Meta.genre, Meta.players, Meta.ctrltype, Meta.buttons, Meta.joyways, Meta.cloneOf, Meta.rating, Meta.score "
-                       "FROM Meta WHERE collectionName=? ORDER BY title ASC;",
+                       "SELECT Meta.name, Meta.title, Meta.year, Meta.manufacturer, Meta.developer, Meta.genre, Meta.players, Meta.ctrltype, Meta.buttons, Meta.joyways, Meta.cloneOf, Meta.rating, Meta.score "
+                       "FROM Meta LEFT JOIN MetaFiles ON MetaFiles.id = Meta.fileId WHERE collectionName=? ORDER BY MetaFiles.rank ASC;",
                        -1, &stmt, 0);
 
     sqlite3_bind_text(stmt, 1, collection->metadataType.c_str(), -1, SQLITE_TRANSIENT);
 
     rc = sqlite3_step(stmt);
 
+    // a game listed by several lists takes its data from the one found last
     while(rc == SQLITE_ROW)
     {
         std::string name = (char *)sqlite3_column_text(stmt, 0);
@@ -289,51 +914,36 @@ void MetadataDatabase::injectMetadata(CollectionInfo *collection)
     sqlite3_finalize(stmt);
 }
 
-bool MetadataDatabase::needsRefresh()
+// Lists are refreshed one by one through the manifest; everything is read
+// again only when RetroFE itself is newer than meta.db, since the importers
+// may have changed.
+bool MetadataDatabase::needsRebuild()
 {
-    sqlite3 *handle = db_.handle;
-    sqlite3_stmt *stmt;
-    bool result;
-
-    sqlite3_prepare_v2(handle,
-                       "SELECT COUNT(*) FROM Meta;",
-                       -1, &stmt, 0);
-
-    int rc = sqlite3_step(stmt);
-
-    if(rc == SQLITE_ROW)
-    {
-        int count = sqlite3_column_int(stmt, 0);
-        struct stat metadb;
-        struct stat exe;
-        int metadbErr  = stat( Utils::combinePath(Configuration::absolutePath, "meta.db").c_str(), &metadb);
+    struct stat metadb;
+    struct stat exe;
+    int metadbErr  = stat( Utils::combinePath(Configuration::absolutePath, "meta.db").c_str(), &metadb);
 #ifdef WIN32
-        int exeErr  = stat( Utils::combinePath(Configuration::absolutePath, "core", "RetroFE.exe").c_str(), &exe);
+    int exeErr  = stat( Utils::combinePath(Configuration::absolutePath, "core", "RetroFE.exe").c_str(), &exe);
 #else
-        int exeErr  = stat( Utils::combinePath(Configuration::absolutePath, "RetroFE").c_str(), &exe);
-        if (exeErr)
-        {
-            exeErr  = stat( Utils::combinePath(Configuration::absolutePath, "retrofe").c_str(), &exe);
-        }
-#endif
-        time_t metadirTime = timeDir(Utils::combinePath(Configuration::absolutePath, "meta"));
-
-        result = (count == 0 || metadbErr || metadb.st_mtime < metadirTime || exeErr || metadb.st_mtime < exe.st_mtime) ? true : false;
-    }
-    else
+    int exeErr  = stat( Utils::combinePath(Configuration::absolutePath, "RetroFE").c_str(), &exe);
+    if (exeErr)
     {
-        result = true;
+        exeErr  = stat( Utils::combinePath(Configuration::absolutePath, "retrofe").c_str(), &exe);
     }
+#endif
 
-    sqlite3_finalize(stmt);
-
-    return result;
+    return (metadbErr || exeErr || metadb.st_mtime < exe.st_mtime) ? true : false;
 }
 
 bool MetadataDatabase::importHyperlist(std::string hyperlistFile, std::string collectionName)
 {
-    char *error = NULL;
+    MetadataWriter writer(db_);
+    return importHyperlist(hyperlistFile, collectionName, writer);
+}
 
+
+bool MetadataDatabase::importHyperlist(std::string hyperlistFile, std::string collectionName, MetadataWriter &writer)
+{
     config_.setProperty("status", "Scraping data from \"" + hyperlistFile + "\"");
     rapidxml::xml_document<> doc;
     std::ifstream file(hyperlistFile.c_str());
@@ -352,8 +962,10 @@ bool MetadataDatabase::importHyperlist(std::string hyperlistFile, std::string co
             Logger::write(Logger::ZONE_ERROR, "Metadata", "Does not appear to be a HyperList file (missing <menu> tag)");
             return false;
         }
-        sqlite3 *handle = db_.handle;
-        sqlite3_exec(handle, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, &error);
+        if(!writer.begin("INSERT OR REPLACE INTO Meta (name, title, year, manufacturer, developer, genre, players, ctrltype, buttons, joyways, cloneOf, collectionName, rating, score, fileId) VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,:fileId)"))
+        {
+            return false;
+        }
         for(rapidxml::xml_node<> *game = root->first_node("game"); game; game = game->next_sibling("game"))
         {
             rapidxml::xml_attribute<> *nameXml = game->first_attribute("name");
@@ -389,33 +1001,25 @@ bool MetadataDatabase::importHyperlist(std::string hyperlistFile, std::string co
 
             if(name.length() > 0)
             {
-                sqlite3_stmt *stmt;
-
-                sqlite3_prepare_v2(handle,
-                                   "INSERT OR REPLACE INTO Meta (name, title, year, manufacturer, developer, genre, players, ctrltype, buttons, joyways, cloneOf, collectionName, rating, score) VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?)",
-                                   -1, &stmt, 0);
-
-                sqlite3_bind_text(stmt,  1, name.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  2, description.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  3, year.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  4, manufacturer.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  5, developer.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  6, genre.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  7, numberPlayers.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  8, ctrlType.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  9, numberButtons.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 10, numberJoyWays.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 11, cloneOf.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 12, collectionName.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 13, rating.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 14, score.c_str(), -1, SQLITE_TRANSIENT);
-
-                sqlite3_step(stmt);
-                sqlite3_finalize(stmt);
+                writer.bind( 1, name);
+                writer.bind( 2, description);
+                writer.bind( 3, year);
+                writer.bind( 4, manufacturer);
+                writer.bind( 5, developer);
+                writer.bind( 6, genre);
+                writer.bind( 7, numberPlayers);
+                writer.bind( 8, ctrlType);
+                writer.bind( 9, numberButtons);
+                writer.bind(10, numberJoyWays);
+                writer.bind(11, cloneOf);
+                writer.bind(12, collectionName);
+                writer.bind(13, rating);
+                writer.bind(14, score);
+                writer.insert();
             }
         }
         config_.setProperty("status", "Saving data from \"" + hyperlistFile + "\" to database");
-        sqlite3_exec(handle, "COMMIT TRANSACTION;", NULL, NULL, &error);
+        writer.commit();
 
         return true;
     }
@@ -440,117 +1044,69 @@ bool MetadataDatabase::importHyperlist(std::string hyperlistFile, std::string co
 
 bool MetadataDatabase::importMamelist(std::string filename, std::string collectionName)
 {
-    rapidxml::xml_document<> doc;
-    rapidxml::xml_node<> * rootNode;
-    char *error = NULL;
-    sqlite3 *handle = db_.handle;
-
-    config_.setProperty("status", "Scraping data from \"" + filename + "\" (this will take a while)");
-
-    Logger::write(Logger::ZONE_INFO, "Mamelist", "Importing mamelist file \"" + filename + "\" (this will take a while)");
-    std::ifstream file(filename.c_str());
+    MetadataWriter writer(db_);
+    return importMamelist(filename, collectionName, writer);
+}
 
-    std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
 
-    buffer.push_back('\0');
+bool MetadataDatabase::importMamelist(std::string filename, std::string collectionName, MetadataWriter &writer)
+{
+    MamelistReader reader;
+    MamelistReader::Machine machine;
 
-    doc.parse<0>(&buffer[0]);
+    config_.setProperty("status", "Scraping data from \"" + filename + "\" (this will take a while)");
 
-    rootNode = doc.first_node("mame");
+    Logger::write(Logger::ZONE_INFO, "Mamelist", "Importing mamelist file \"" + filename + "\" (this will take a while)");
 
-    if(!rootNode)
+    // machines are read and inserted one at a time, the file is never held in memory
+    if(!reader.open(filename))
     {
         Logger::write(Logger::ZONE_ERROR, "Metadata", "Does not appear to be a MameList file (missing <mame> tag)");
         return false;
     }
 
-    if(sqlite3_exec(handle, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, &error) != SQLITE_OK)
+    if(!writer.begin("INSERT OR REPLACE INTO Meta (name, title, year, manufacturer, genre, players, buttons, cloneOf, collectionName, fileId) VALUES (?,?,?,?,?,?,?,?,?,:fileId)"))
     {
-        std::string emsg = error;
-        Logger::write(Logger::ZONE_ERROR, "Metadata", "SQL Error starting transaction: " + emsg);
         return false;
-    };
-    std::string gameNodeName = "game";
-
-    // support new mame formats
-    if(rootNode->first_node(gameNodeName.c_str()) == NULL) {
-        gameNodeName = "machine";
     }
 
-    for (rapidxml::xml_node<> * game = rootNode->first_node(gameNodeName.c_str()); game; game = game->next_sibling())
-    {
-        rapidxml::xml_attribute<> *nameNode = game->first_attribute("name");
-        rapidxml::xml_attribute<> *cloneOfXml = game->first_attribute("cloneof");
+    int lastProgress = -1;
 
-        if(nameNode != NULL)
+    while(reader.next(machine))
+    {
+        int progress = reader.progress();
+        if(progress != lastProgress)
         {
-            std::string name = nameNode->value();
-            rapidxml::xml_node<> *descriptionNode = game->first_node("description");
-            rapidxml::xml_node<> *yearNode = game->first_node("year");
-            rapidxml::xml_node<> *manufacturerNode = game->first_node("manufacturer");
-            rapidxml::xml_node<> *genreNode = game->first_node("genre");
-            rapidxml::xml_node<> *inputNode = game->first_node("input");
-
-            std::string description = (descriptionNode == NULL) ? nameNode->value() : descriptionNode->value();
-            std::string year = (yearNode == NULL) ? "" : yearNode->value();
-            std::string manufacturer = (manufacturerNode == NULL) ? "" : manufacturerNode->value();
-            std::string genre = (genreNode == NULL) ? "" : genreNode->value();
-            std::string cloneOf = (cloneOfXml == NULL) ? "" : cloneOfXml->value();
-            std::string players;
-            std::string buttons;
-
-            if(inputNode != NULL)
-            {
-                rapidxml::xml_attribute<> *playersAttribute = inputNode->first_attribute("players");
-                rapidxml::xml_attribute<> *buttonsAttribute = inputNode->first_attribute("buttons");
-
-                if(playersAttribute)
-                {
-                    players = playersAttribute->value();
-                }
-
-                if(buttonsAttribute)
-                {
-                    buttons = buttonsAttribute->value();
-                }
-
-            }
-
-            sqlite3_stmt *stmt;
-
-            sqlite3_prepare_v2(handle,
-                               "INSERT OR REPLACE INTO Meta (name, title, year, manufacturer, genre, players, buttons, cloneOf, collectionName) VALUES (?,?,?,?,?,?,?,?,?)",
-                               -1, &stmt, 0);
-
+            std::stringstream ss;
+            ss << "Scraping data from \"" << filename << "\" (" << progress << "%)";
+            config_.setProperty("status", ss.str());
+            lastProgress = progress;
+        }
 
-            sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(stmt, 2, description.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(stmt, 3, year.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(stmt, 4, manufacturer.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(stmt, 5, genre.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(stmt, 6, players.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(stmt, 7, buttons.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(stmt, 8, cloneOf.c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(stmt, 9, collectionName.c_str(), -1, SQLITE_TRANSIENT);
+        writer.bind(1, machine.name);
+        writer.bind(2, machine.description);
+        writer.bind(3, machine.year);
+        writer.bind(4, machine.manufacturer);
+        writer.bind(5, machine.genre);
+        writer.bind(6, machine.players);
+        writer.bind(7, machine.buttons);
+        writer.bind(8, machine.cloneOf);
+        writer.bind(9, collectionName);
+
+        if (!writer.insert())
+        {
+            Logger::write(Logger::ZONE_ERROR, "Metadata", "Failed to insert machine \"" + machine.name + "\" into database; " + writer.error());
+            break;
+        };
+    }
 
-            if (int code = sqlite3_step(stmt) != SQLITE_DONE)
-            {
-                std::stringstream ss;
-                ss << "Failed to insert machine \"" << name << "\" into database; " << sqlite3_errstr(code) << "; " << sqlite3_errmsg(handle);
-                Logger::write(Logger::ZONE_ERROR, "Metadata", ss.str());
-                sqlite3_finalize(stmt);
-                break;
-            };
-            sqlite3_finalize(stmt);
-        }
+    if(reader.error())
+    {
+        Logger::write(Logger::ZONE_ERROR, "Metadata", "Mamelist file \"" + filename + "\" ends unexpectedly; keeping the machines read so far");
     }
 
     config_.setProperty("status", "Saving data from \"" + filename + "\" to database");
-    if (sqlite3_exec(handle, "COMMIT TRANSACTION;", NULL, NULL, &error) != SQLITE_OK)
-    {
-        std::string emsg = error;
-        Logger::write(Logger::ZONE_ERROR, "Metadata", "SQL Error closing transaction: " + emsg);
-    };
+    writer.commit();
 
     return true;
 }
@@ -558,8 +1114,13 @@ bool MetadataDatabase::importMamelist(std::string filename, std::string collecti
 
 bool MetadataDatabase::importEmuArclist(std::string emuarclistFile)
 {
-    char *error = NULL;
+    MetadataWriter writer(db_);
+    return importEmuArclist(emuarclistFile, writer);
+}
+
 
+bool MetadataDatabase::importEmuArclist(std::string emuarclistFile, MetadataWriter &writer)
+{
     config_.setProperty("status", "Scraping data from \"" + emuarclistFile + "\"");
     rapidxml::xml_document<> doc;
     std::ifstream file(emuarclistFile.c_str());
@@ -597,9 +1158,10 @@ bool MetadataDatabase::importEmuArclist(std::string emuarclistFile)
         {
             collectionName = collectionName.substr(0, pos);
         }
-        sqlite3 *handle = db_.handle;
-        sqlite3_exec(handle, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, &error);
-        
+        if(!writer.begin("INSERT OR REPLACE INTO Meta (name, title, year, manufacturer, developer, genre, players, ctrltype, buttons, joyways, cloneOf, collectionName, rating, score, fileId) VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,:fileId)"))
+        {
+            return false;
+        }
 
         for(rapidxml::xml_node<> *game = root->first_node("game"); game; game = game->next_sibling("game"))
         {
@@ -639,33 +1201,25 @@ bool MetadataDatabase::importEmuArclist(std::string emuarclistFile)
 
             if(name.length() > 0)
             {
-                sqlite3_stmt *stmt;
-
-                sqlite3_prepare_v2(handle,
-                                   "INSERT OR REPLACE INTO Meta (name, title, year, manufacturer, developer, genre, players, ctrltype, buttons, joyways, cloneOf, collectionName, rating, score) VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?)",
-                                   -1, &stmt, 0);
-
-                sqlite3_bind_text(stmt,  1, name.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  2, description.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  3, year.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  4, manufacturer.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  5, developer.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  6, genre.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  7, numberPlayers.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  8, ctrlType.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt,  9, numberButtons.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 10, numberJoyWays.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 11, cloneOf.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 12, collectionName.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 13, rating.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_text(stmt, 14, score.c_str(), -1, SQLITE_TRANSIENT);
-
-                sqlite3_step(stmt);
-                sqlite3_finalize(stmt);
+                writer.bind( 1, name);
+                writer.bind( 2, description);
+                writer.bind( 3, year);
+                writer.bind( 4, manufacturer);
+                writer.bind( 5, developer);
+                writer.bind( 6, genre);
+                writer.bind( 7, numberPlayers);
+                writer.bind( 8, ctrlType);
+                writer.bind( 9, numberButtons);
+                writer.bind(10, numberJoyWays);
+                writer.bind(11, cloneOf);
+                writer.bind(12, collectionName);
+                writer.bind(13, rating);
+                writer.bind(14, score);
+                writer.insert();
             }
         }
         config_.setProperty("status", "Saving data from \"" + emuarclistFile + "\" to database");
-        sqlite3_exec(handle, "COMMIT TRANSACTION;", NULL, NULL, &error);
+        writer.commit();
 
         return true;
     }
@@ -687,36 +1241,3 @@ bool MetadataDatabase::importEmuArclist(std::string emuarclistFile)
 
     return false;
 }
-
-
-time_t MetadataDatabase::timeDir( std::string path )
-{
-    time_t lastTime = 0;
-    DIR *dp;
-    struct dirent *dirp;
-
-    dp = opendir( path.c_str( ) );
-
-    while (dp != NULL && (dirp = readdir( dp )) != NULL)
-    {
-        std::string file = dirp->d_name;
-
-        // Check if file is a directory
-        struct stat sb;
-        if (file != "." && file != ".." && stat( Utils::combinePath( path, file ).c_str( ), &sb ) == 0 && S_ISDIR( sb.st_mode ))
-        {
-            time_t tmpTime = timeDir( Utils::combinePath( path, file ) );
-            lastTime = (tmpTime > lastTime) ? tmpTime : lastTime;
-        }
-        else if (file != "." && file != "..")
-        {
-            struct stat filestat;
-            int err = stat( Utils::combinePath( path, file ).c_str( ), &filestat );
-            lastTime = (!err && filestat.st_mtime > lastTime) ? filestat.st_mtime : lastTime;
-        }
-    }
-
-    if (dp) closedir( dp );
-
-    return lastTime;
-}
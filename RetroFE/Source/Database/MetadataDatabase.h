@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "../Utility/WorkQueue.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -23,6 +24,7 @@ class DB;
 class Configuration;
 class CollectionInfo;
 class Item;
+class MetadataWriter;
 
 class MetadataDatabase
 {
@@ -38,9 +40,73 @@ public:
     bool importEmuArclist(std::string filename);
 
 private:
+    class ImportJob;
+    typedef std::vector<std::vector<std::string> > Batch;
+
+    // state shared between the parsing jobs and the writer thread
+    struct ImportQueue
+    {
+        ImportQueue(DB &db);
+        ~ImportQueue();
+        DB                      &db;
+        SDL_mutex               *mutex;
+        SDL_cond                *cond;
+        std::vector<ImportJob *> jobs;
+        bool                     failed; // set by the writer thread
+    };
+
+    enum ListType
+    {
+        HYPERLIST,
+        MAMELIST,
+        EMUARCLIST
+    };
+
+    struct ListFile
+    {
+        ListType    type;
+        std::string name; // relative to meta/, as kept in the manifest
+        std::string path;
+        std::string collectionName;
+    };
+
+    // what meta.db remembers about a list it imported
+    struct ManifestEntry
+    {
+        long long id;
+        long long size;
+        long long mtime;
+        long long hash;
+        int       rank;
+        bool      seen;
+    };
+    typedef std::map<std::string, ManifestEntry> Manifest;
+
+    struct BulkImport
+    {
+        bool        dropIndexes;
+        std::string synchronous;
+        std::string journalMode;
+        std::string cacheSize;
+    };
+
+    bool createTables();
     bool importDirectory();
-    bool needsRefresh();
-    time_t timeDir(std::string path);
+    void findLists(std::string metaPath, std::string dir, std::string extension, ListType type, std::vector<ListFile> &lists);
+    bool readManifest(Manifest &manifest);
+    long long addToManifest(std::string path);
+    bool setManifestRank(long long id, int rank);
+    bool removeFromManifest(long long id);
+    bool runImports(ImportQueue &queue, std::vector<WorkQueue::Job *> &jobs);
+    static int writeImports(void *context);
+    bool importHyperlist(std::string hyperlistFile, std::string collectionName, MetadataWriter &writer);
+    bool importMamelist(std::string filename, std::string collectionName, MetadataWriter &writer);
+    bool importEmuArclist(std::string filename, MetadataWriter &writer);
+    void beginBulkImport(BulkImport &bulk);
+    void endBulkImport(BulkImport &bulk);
+    std::string pragmaValue(std::string name);
+    bool hasIndex(std::string name);
+    bool needsRebuild();
     Configuration &config_;
     DB &db_;
 };
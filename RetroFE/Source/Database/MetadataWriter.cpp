@@ -0,0 +1,109 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MetadataWriter.h"
+#include "DB.h"
+#include "../Utility/Log.h"
+
+MetadataWriter::MetadataWriter(DB &db, sqlite3_int64 fileId)
+    : handle_(db.handle)
+    , stmt_(NULL)
+    , open_(false)
+    , fileId_(fileId)
+    , fileIdParameter_(0)
+{
+}
+
+
+MetadataWriter::~MetadataWriter()
+{
+    commit();
+}
+
+
+bool MetadataWriter::begin(const char *insertSql)
+{
+    char *sqlError = NULL;
+
+    if(sqlite3_exec(handle_, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, &sqlError) != SQLITE_OK)
+    {
+        std::string emsg = (sqlError) ? sqlError : "";
+        sqlite3_free(sqlError);
+        Logger::write(Logger::ZONE_ERROR, "Metadata", "SQL Error starting transaction: " + emsg);
+        return false;
+    }
+    open_ = true;
+
+    if(sqlite3_prepare_v2(handle_, insertSql, -1, &stmt_, 0) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Metadata", "SQL Error preparing insert: " + error());
+        commit();
+        return false;
+    }
+    fileIdParameter_ = sqlite3_bind_parameter_index(stmt_, ":fileId");
+
+    return true;
+}
+
+
+void MetadataWriter::bind(int parameter, const std::string &value)
+{
+    sqlite3_bind_text(stmt_, parameter, value.c_str(), -1, SQLITE_TRANSIENT);
+}
+
+
+bool MetadataWriter::insert()
+{
+    if(fileIdParameter_) sqlite3_bind_int64(stmt_, fileIdParameter_, fileId_);
+
+    int rc = sqlite3_step(stmt_);
+    sqlite3_reset(stmt_);
+    sqlite3_clear_bindings(stmt_);
+
+    return rc == SQLITE_DONE;
+}
+
+
+bool MetadataWriter::commit()
+{
+    char *sqlError = NULL;
+    bool retval = true;
+
+    if(stmt_)
+    {
+        sqlite3_finalize(stmt_);
+        stmt_ = NULL;
+    }
+
+    if(open_)
+    {
+        open_ = false;
+        if(sqlite3_exec(handle_, "COMMIT TRANSACTION;", NULL, NULL, &sqlError) != SQLITE_OK)
+        {
+            std::string emsg = (sqlError) ? sqlError : "";
+            sqlite3_free(sqlError);
+            Logger::write(Logger::ZONE_ERROR, "Metadata", "SQL Error closing transaction: " + emsg);
+            retval = false;
+        }
+    }
+
+    return retval;
+}
+
+
+std::string MetadataWriter::error()
+{
+    return sqlite3_errmsg(handle_);
+}
@@ -0,0 +1,55 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <sqlite3.h>
+#include <string>
+
+class DB;
+
+// Writes the rows of one metadata import: a single transaction and a single
+// prepared INSERT that is reset and rebound for every row. The importers
+// only see this interface, so the rows can be handed elsewhere instead.
+class MetadataWriter
+{
+public:
+    // Rows are tagged with fileId through the :fileId parameter, when the
+    // insert statement has one.
+    MetadataWriter(DB &db, sqlite3_int64 fileId = 0);
+    virtual ~MetadataWriter();
+
+    // Starts the transaction and prepares insertSql.
+    virtual bool begin(const char *insertSql);
+
+    // Binds a value to the 1-based parameter of the current row.
+    virtual void bind(int parameter, const std::string &value);
+
+    // Writes the current row and readies the statement for the next one.
+    virtual bool insert();
+
+    // Ends the transaction. Called by the destructor if the import bails
+    // out early, so the rows written so far are kept.
+    virtual bool commit();
+
+    virtual std::string error();
+
+private:
+    sqlite3      *handle_;
+    sqlite3_stmt *stmt_;
+    bool          open_;
+    sqlite3_int64 fileId_;
+    int           fileIdParameter_;
+};
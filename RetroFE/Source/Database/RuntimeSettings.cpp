@@ -0,0 +1,94 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RuntimeSettings.h"
+#include "Configuration.h"
+#include "../Utility/Utils.h"
+
+RuntimeSettings::RuntimeSettings()
+    : firstCollection("Main")
+    , firstPlaylist("all")
+    , autoPlaylist("all")
+    , fps(60)
+    , fpsIdle(60)
+    , attractModeTime(0)
+    , attractModeNextTime(0)
+    , attractModePlaylistTime(0)
+    , attractModeCollectionTime(0)
+    , attractModeMinTime(1000)
+    , attractModeMaxTime(5000)
+    , attractModePlaylistCollectionNumber(0)
+    , attractModeCyclePlaylist(false)
+    , lastplayedSize(0)
+    , lastplayedCollectionSize(0)
+    , startCollectionEnter(false)
+    , enterOnCollection(true)
+    , rememberMenu(false)
+    , backOnEmpty(false)
+    , backOnCollection(false)
+    , exitOnFirstPageBack(false)
+    , cfwLetterSub(false)
+    , subsSplit(false)
+    , playlistInputClear(false)
+    , jumpInputClear(false)
+    , collectionInputClear(false)
+{
+}
+
+
+// Settings that are not configured keep the defaults set above.
+void RuntimeSettings::load(Configuration &config)
+{
+    config.getProperty("layout", layout);
+    config.getProperty("firstCollection", firstCollection);
+    config.getProperty("firstPlaylist", firstPlaylist);
+    config.getProperty("autoPlaylist", autoPlaylist);
+
+    std::string cycleString;
+    config.getProperty("cyclePlaylist", cycleString);
+    cyclePlaylist.clear();
+    Utils::listToVector(cycleString, cyclePlaylist, ',');
+
+    config.getProperty("fps", fps);
+    config.getProperty("fpsIdle", fpsIdle);
+
+    config.getProperty("attractModeTime", attractModeTime);
+    config.getProperty("attractModeNextTime", attractModeNextTime);
+    config.getProperty("attractModePlaylistTime", attractModePlaylistTime);
+    config.getProperty("attractModeCollectionTime", attractModeCollectionTime);
+    config.getProperty("attractModeMinTime", attractModeMinTime);
+    config.getProperty("attractModeMaxTime", attractModeMaxTime);
+    config.getProperty("attractModePlaylistCollectionNumber", attractModePlaylistCollectionNumber);
+    config.getProperty("attractModeCyclePlaylist", attractModeCyclePlaylist);
+    config.getProperty("attractModeSkipPlaylist", attractModeSkipPlaylist);
+    config.getProperty("attractModeSkipCollection", attractModeSkipCollection);
+
+    config.getProperty("lastPlayedSkipCollection", lastPlayedSkipCollection);
+    config.getProperty("lastplayedSize", lastplayedSize);
+    config.getProperty("lastplayedCollectionSize", lastplayedCollectionSize);
+
+    config.getProperty("startCollectionEnter", startCollectionEnter);
+    config.getProperty("enterOnCollection", enterOnCollection);
+    config.getProperty("rememberMenu", rememberMenu);
+    config.getProperty("backOnEmpty", backOnEmpty);
+    config.getProperty("backOnCollection", backOnCollection);
+    config.getProperty("exitOnFirstPageBack", exitOnFirstPageBack);
+    config.getProperty("cfwLetterSub", cfwLetterSub);
+    config.getProperty("subsSplit", subsSplit);
+
+    config.getProperty("playlistInputClear", playlistInputClear);
+    config.getProperty("jumpInputClear", jumpInputClear);
+    config.getProperty("collectionInputClear", collectionInputClear);
+}
@@ -0,0 +1,68 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Configuration;
+
+// Settings the main loop, attract mode and input handling act on. They are
+// read once when RetroFE starts, so nothing is looked up by name while
+// running; a reboot starts over with a freshly loaded configuration.
+class RuntimeSettings
+{
+public:
+    RuntimeSettings();
+    void load(Configuration &config);
+
+    std::string layout;
+    std::string firstCollection;
+    std::string firstPlaylist;
+    std::string autoPlaylist;
+    std::vector<std::string> cyclePlaylist;
+
+    int   fps;
+    int   fpsIdle;
+
+    int   attractModeTime;
+    int   attractModeNextTime;
+    int   attractModePlaylistTime;
+    int   attractModeCollectionTime;
+    int   attractModeMinTime;
+    int   attractModeMaxTime;
+    int   attractModePlaylistCollectionNumber;
+    bool  attractModeCyclePlaylist;
+    std::string attractModeSkipPlaylist;
+    std::string attractModeSkipCollection;
+
+    std::string lastPlayedSkipCollection;
+    int   lastplayedSize;
+    int   lastplayedCollectionSize;
+
+    bool  startCollectionEnter;
+    bool  enterOnCollection;
+    bool  rememberMenu;
+    bool  backOnEmpty;
+    bool  backOnCollection;
+    bool  exitOnFirstPageBack;
+    bool  cfwLetterSub;
+    bool  subsSplit;
+
+    bool  playlistInputClear;
+    bool  jumpInputClear;
+    bool  collectionInputClear;
+};
@@ -229,7 +229,10 @@ void Component::draw()
                                static_cast<char>(baseViewInfo.BackgroundGreen*255),
                                static_cast<char>(baseViewInfo.BackgroundBlue*255));
 
-        SDL::renderCopy(backgroundTexture_, baseViewInfo.BackgroundAlpha, NULL, &rect, baseViewInfo, page.getLayoutWidth(baseViewInfo.Monitor), page.getLayoutHeight(baseViewInfo.Monitor));
+        // the background texture is the 4x4 surface made in allocateGraphicsMemory
+        SDL_Rect src = {0, 0, 4, 4};
+
+        SDL::renderCopy(backgroundTexture_, baseViewInfo.BackgroundAlpha, &src, &rect, baseViewInfo, page.getLayoutWidth(baseViewInfo.Monitor), page.getLayoutHeight(baseViewInfo.Monitor));
     }
 }
 
@@ -16,14 +16,34 @@
 #include "Image.h"
 #include "../ViewInfo.h"
 #include "../../SDL.h"
+#include "../TextureCache.h"
 #include "../../Utility/Log.h"
-#include <SDL2/SDL_image.h>
 
 Image::Image(std::string file, std::string altFile, Page &p, int monitor)
     : Component(p)
     , texture_(NULL)
+    , textureRect_()
     , file_(file)
     , altFile_(altFile)
+    , async_(false)
+    , placeholder_(NULL)
+    , request_(NULL)
+    , loaded_(false)
+{
+    baseViewInfo.Monitor = monitor;
+    allocateGraphicsMemory();
+}
+
+Image::Image(std::vector<std::string> &prefixes, std::vector<std::string> &extensions, Component *placeholder, Page &p, int monitor)
+    : Component(p)
+    , texture_(NULL)
+    , textureRect_()
+    , async_(true)
+    , prefixes_(prefixes)
+    , extensions_(extensions)
+    , placeholder_(placeholder)
+    , request_(NULL)
+    , loaded_(false)
 {
     baseViewInfo.Monitor = monitor;
     allocateGraphicsMemory();
@@ -32,44 +52,57 @@ Image::Image(std::string file, std::string altFile, Page &p, int monitor)
 Image::~Image()
 {
     freeGraphicsMemory();
+    if (placeholder_)
+    {
+        delete placeholder_;
+        placeholder_ = NULL;
+    }
 }
 
 void Image::freeGraphicsMemory()
 {
     Component::freeGraphicsMemory();
 
-    SDL_LockMutex(SDL::getMutex());
+    if (request_)
+    {
+        ImageLoader::release(request_);
+        request_ = NULL;
+    }
+    loaded_ = false;
+
+    if (placeholder_)
+    {
+        placeholder_->freeGraphicsMemory();
+    }
+
     if (texture_ != NULL)
     {
-        SDL_DestroyTexture(texture_);
+        TextureCache::release(texture_);
         texture_ = NULL;
     }
-    SDL_UnlockMutex(SDL::getMutex());
 }
 
 void Image::allocateGraphicsMemory()
 {
-    int width;
-    int height;
-
-    if(!texture_)
+    if(async_)
     {
-        SDL_LockMutex(SDL::getMutex());
-        texture_ = IMG_LoadTexture(SDL::getRenderer(baseViewInfo.Monitor), file_.c_str());
-        if (!texture_ && altFile_ != "")
+        if(!texture_ && !request_ && !loaded_)
         {
-            texture_ = IMG_LoadTexture(SDL::getRenderer(baseViewInfo.Monitor), altFile_.c_str());
+            request_ = ImageLoader::load(prefixes_, extensions_, baseViewInfo.Monitor);
         }
-
-        if (texture_ != NULL)
+        if(placeholder_)
         {
-            SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
-            SDL_QueryTexture(texture_, NULL, NULL, &width, &height);
-            baseViewInfo.ImageWidth  = (float)width;
-            baseViewInfo.ImageHeight = (float)height;
+            placeholder_->allocateGraphicsMemory();
         }
-        SDL_UnlockMutex(SDL::getMutex());
-
+    }
+    else if(!texture_)
+    {
+        texture_ = TextureCache::load(file_, baseViewInfo.Monitor);
+        if (!texture_ && altFile_ != "")
+        {
+            texture_ = TextureCache::load(altFile_, baseViewInfo.Monitor);
+        }
+        updateImageSize();
     }
 
     Component::allocateGraphicsMemory();
@@ -77,10 +110,69 @@ void Image::allocateGraphicsMemory()
 }
 
 
+void Image::deInitializeFonts()
+{
+    if (placeholder_)
+    {
+        placeholder_->deInitializeFonts();
+    }
+}
+
+
+void Image::initializeFonts()
+{
+    if (placeholder_)
+    {
+        placeholder_->initializeFonts();
+    }
+}
+
+
+void Image::updateImageSize()
+{
+    int width;
+    int height;
+
+    if (texture_ != NULL)
+    {
+        SDL_QueryTexture(texture_, NULL, NULL, &width, &height);
+        baseViewInfo.ImageWidth  = (float)width;
+        baseViewInfo.ImageHeight = (float)height;
+        textureRect_.x = 0;
+        textureRect_.y = 0;
+        textureRect_.w = width;
+        textureRect_.h = height;
+    }
+}
+
+
 void Image::draw()
 {
     Component::draw();
 
+    // pick up the decoded surface once the loader is done with it
+    if(request_)
+    {
+        SDL_Surface *surface = NULL;
+        if(ImageLoader::poll(request_, surface, file_))
+        {
+            ImageLoader::release(request_);
+            request_ = NULL;
+            loaded_  = true;
+            if(surface)
+            {
+                texture_ = TextureCache::insert(file_, baseViewInfo.Monitor, surface);
+                SDL_FreeSurface(surface);
+            }
+            else if(file_ != "")
+            {
+                // already cached when the loader got to it (or evicted since)
+                texture_ = TextureCache::load(file_, baseViewInfo.Monitor);
+            }
+            updateImageSize();
+        }
+    }
+
     if(texture_)
     {
         SDL_Rect rect;
@@ -90,6 +182,12 @@ void Image::draw()
         rect.h = static_cast<int>(baseViewInfo.ScaledHeight());
         rect.w = static_cast<int>(baseViewInfo.ScaledWidth());
 
-        SDL::renderCopy(texture_, baseViewInfo.Alpha, NULL, &rect, baseViewInfo, page.getLayoutWidth(baseViewInfo.Monitor), page.getLayoutHeight(baseViewInfo.Monitor));
+        SDL::renderCopy(texture_, baseViewInfo.Alpha, &textureRect_, &rect, baseViewInfo, page.getLayoutWidth(baseViewInfo.Monitor), page.getLayoutHeight(baseViewInfo.Monitor));
+    }
+    else if(placeholder_)
+    {
+        placeholder_->baseViewInfo                 = baseViewInfo;
+        placeholder_->baseViewInfo.BackgroundAlpha = 0;
+        placeholder_->draw();
     }
 }
@@ -16,20 +16,37 @@
 #pragma once
 
 #include "Component.h"
+#include "../ImageLoader.h"
 #include <SDL2/SDL.h>
 #include <string>
+#include <vector>
 
 class Image : public Component
 {
 public:
     Image(std::string file, std::string altFile, Page &p, int monitor);
+    Image(std::vector<std::string> &prefixes, std::vector<std::string> &extensions, Component *placeholder, Page &p, int monitor);
     virtual ~Image();
     void freeGraphicsMemory();
     void allocateGraphicsMemory();
+    void deInitializeFonts();
+    void initializeFonts();
     void draw();
 
 protected:
     SDL_Texture *texture_;
+    SDL_Rect     textureRect_;
     std::string  file_;
     std::string  altFile_;
+
+private:
+    void updateImageSize();
+
+    // asynchronous loading; the placeholder is drawn until the texture is ready
+    bool                     async_;
+    std::vector<std::string> prefixes_;
+    std::vector<std::string> extensions_;
+    Component               *placeholder_;
+    ImageLoader::Request    *request_;
+    bool                     loaded_;
 };
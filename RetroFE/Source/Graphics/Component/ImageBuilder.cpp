@@ -14,6 +14,7 @@
  * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "ImageBuilder.h"
+#include "../../Utility/MediaIndex.h"
 #include "../../Utility/Utils.h"
 #include "../../Utility/Log.h"
 #include <fstream>
@@ -23,20 +24,39 @@ Image * ImageBuilder::CreateImage(std::string path, Page &p, std::string name, i
     Image *image = NULL;
     std::vector<std::string> extensions;
 
-    extensions.push_back("png");
-    extensions.push_back("PNG");
-    extensions.push_back("jpg");
-    extensions.push_back("JPG");
-    extensions.push_back("jpeg");
-    extensions.push_back("JPEG");
+    getExtensions(extensions);
 
     std::string prefix = Utils::combinePath(path, name);
     std::string file;
 
-    if(Utils::findMatchingFile(prefix, extensions, file))
+    if(MediaIndex::findMatchingFile(prefix, extensions, file))
     {
         image = new Image(file, "", p, monitor);
     }
 
     return image;
 }
+
+
+// Resolution and decoding happen on the image loader threads; the
+// placeholder is drawn until the artwork is ready, or for good if no
+// prefix matches.
+Image * ImageBuilder::CreateAsyncImage(std::vector<std::string> &prefixes, Page &p, Component *placeholder, int monitor)
+{
+    std::vector<std::string> extensions;
+
+    getExtensions(extensions);
+
+    return new Image(prefixes, extensions, placeholder, p, monitor);
+}
+
+
+void ImageBuilder::getExtensions(std::vector<std::string> &extensions)
+{
+    extensions.push_back("png");
+    extensions.push_back("PNG");
+    extensions.push_back("jpg");
+    extensions.push_back("JPG");
+    extensions.push_back("jpeg");
+    extensions.push_back("JPEG");
+}
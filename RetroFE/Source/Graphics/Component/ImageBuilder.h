@@ -25,4 +25,6 @@ class ImageBuilder
 {
 public:
     Image * CreateImage(std::string path, Page &p, std::string name, int monitor);
+    Image * CreateAsyncImage(std::vector<std::string> &prefixes, Page &p, Component *placeholder, int monitor);
+    static void getExtensions(std::vector<std::string> &extensions);
 };
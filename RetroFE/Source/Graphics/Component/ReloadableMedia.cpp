@@ -31,6 +31,9 @@
 ReloadableMedia::ReloadableMedia(Configuration &config, bool systemMode, bool layoutMode, bool commonMode, bool menuMode, std::string type, std::string imageType, Page &p, int displayOffset, bool isVideo, Font *font, bool jukebox, int jukeboxNumLoops)
     : Component(p)
     , config_(config)
+    , currentCollectionSetting_(config.getHandle("currentCollection"))
+    , overwriteXMLSetting_(config.getHandle("overwriteXML"))
+    , layoutSetting_(config.getHandle("layout"))
     , systemMode_(systemMode)
     , layoutMode_(layoutMode)
     , commonMode_(commonMode)
@@ -126,7 +129,7 @@ void ReloadableMedia::reloadTexture()
     Item *selectedItem = page.getSelectedItem(displayOffset_);
     if(!selectedItem) return;
 
-    config_.getProperty("currentCollection", currentCollection_);
+    config_.getProperty(currentCollectionSetting_, currentCollection_);
 
     // build clone list
     std::vector<std::string> names;
@@ -331,7 +334,7 @@ void ReloadableMedia::reloadTexture()
         }
 
         bool overwriteXML = false;
-        config_.getProperty( "overwriteXML", overwriteXML );
+        config_.getProperty( overwriteXMLSetting_, overwriteXML );
         if ( !defined || overwriteXML ) // No basename was found yet; check the info in stead
         {
             std::string basename_tmp;
@@ -431,7 +434,7 @@ Component *ReloadableMedia::findComponent(std::string collection, std::string ty
     if (layoutMode_)
     {
         std::string layoutName;
-        config_.getProperty("layout", layoutName);
+        config_.getProperty(layoutSetting_, layoutName);
         if (commonMode_)
         {
             imagePath = Utils::combinePath(Configuration::absolutePath, "layouts", layoutName, "collections", "_common");
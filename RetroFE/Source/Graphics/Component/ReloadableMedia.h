@@ -18,6 +18,7 @@
 #include "ReloadableText.h"
 #include "../../Video/IVideo.h"
 #include "../../Collection/Item.h"
+#include "../../Database/Configuration.h"
 #include <SDL2/SDL.h>
 #include <string>
 
@@ -51,6 +52,9 @@ public:
 private:
     void reloadTexture();
     Configuration &config_;
+    Configuration::Handle currentCollectionSetting_;
+    Configuration::Handle overwriteXMLSetting_;
+    Configuration::Handle layoutSetting_;
     bool systemMode_;
     bool layoutMode_;
     bool commonMode_;
@@ -31,6 +31,8 @@
 ReloadableScrollingText::ReloadableScrollingText(Configuration &config, bool systemMode, bool layoutMode, bool menuMode, std::string type, std::string textFormat, std::string singlePrefix, std::string singlePostfix, std::string pluralPrefix, std::string pluralPostfix, std::string alignment, Page &p, int displayOffset, Font *font, std::string direction, float scrollingSpeed, float startPosition, float startTime, float endTime )
     : Component(p)
     , config_(config)
+    , currentCollectionSetting_(config.getHandle("currentCollection"))
+    , layoutSetting_(config.getHandle("layout"))
     , systemMode_(systemMode)
     , layoutMode_(layoutMode)
     , menuMode_(menuMode)
@@ -149,7 +151,7 @@ void ReloadableScrollingText::reloadTexture( )
         return;
     }
 
-    config_.getProperty( "currentCollection", currentCollection_ );
+    config_.getProperty( currentCollectionSetting_, currentCollection_ );
 
     // build clone list
     std::vector<std::string> names;
@@ -392,7 +394,7 @@ void ReloadableScrollingText::loadText( std::string collection, std::string type
     if (layoutMode_)
     {
         std::string layoutName;
-        config_.getProperty("layout", layoutName);
+        config_.getProperty(layoutSetting_, layoutName);
         textPath = Utils::combinePath(Configuration::absolutePath, "layouts", layoutName, "collections", collection);
         if (systemMode)
             textPath = Utils::combinePath(textPath, "system_artwork");
@@ -460,7 +462,7 @@ void ReloadableScrollingText::draw( )
         else                   // If not, use the general font settings
           font = fontInst_;
 
-        SDL_Texture *t = font->getTexture( );
+        batch_.begin( );
 
         float imageWidth     = 0;
         float imageMaxWidth  = 0;
@@ -505,12 +507,12 @@ void ReloadableScrollingText::draw( )
 
             for (unsigned int l = 0; l < text_.size( ); ++l)
             {
-                for (unsigned int i = 0; i < text_[l].size( ); ++i)
+                for (unsigned int i = 0; i < text_[l].size( ); )
                 {
 
                     Font::GlyphInfo glyph;
 
-                    if (font->getRect( text_[l][i], glyph) && glyph.rect.h > 0)
+                    if (font->getRect( Utils::decodeUtf8( text_[l], i ), glyph) && glyph.rect.h > 0)
                     {
                         textWidth_ += static_cast<int>(glyph.advance * scale);
 
@@ -549,7 +551,7 @@ void ReloadableScrollingText::draw( )
                             }
                             if (rect.w > 0)
                             {
-                                SDL::renderCopy(t, baseViewInfo.Alpha, &charRect, &rect, baseViewInfo, page.getLayoutWidth(baseViewInfo.Monitor), page.getLayoutHeight(baseViewInfo.Monitor));
+                                batch_.add( glyph.texture, charRect, rect );
                                 rect.x += rect.w;
                             }
                             else if ((rect.x + static_cast<int>( glyph.advance * scale )) >= (static_cast<int>( xOrigin ) + imageMaxWidth))
@@ -564,17 +566,8 @@ void ReloadableScrollingText::draw( )
             }
 
             // Determine image width
-            for (unsigned int l = 0; l < text_.size( ); ++l)
-            {
-                for (unsigned int i = 0; i < text_[l].size( ); ++i)
-                {
-                    Font::GlyphInfo glyph;
-                    if (font->getRect( text_[l][i], glyph ))
-                    {
-                        imageWidth += glyph.advance;
-                    }
-                }
-            }
+            layout_.wrap( text_, font, baseViewInfo.FontSize, imageMaxWidth );
+            imageWidth = layout_.getWidth( );
 
             // Reset scrolling position when we're done
             if (currentPosition_ > imageWidth * scale)
@@ -588,80 +581,11 @@ void ReloadableScrollingText::draw( )
         else if (direction_ == "vertical")
         {
 
-            unsigned int spaceWidth = 0;
-            {
-                Font::GlyphInfo glyph;
-                if (font->getRect( ' ', glyph) )
-                {
-                    spaceWidth = static_cast<int>( glyph.advance * scale);
-                }
-            }
-
-            // Reformat the text based on the image width
-            std::vector<std::string>  text;
-            std::vector<unsigned int> textWords;
-            std::vector<unsigned int> textWidth;
-            std::vector<bool>         textLast;
-            for (unsigned int l = 0; l < text_.size( ); ++l)
-            {
-                std::string        line = "";
-                std::istringstream iss(text_[l]);
-                std::string        word;
-                unsigned int       width     = 0;
-                unsigned int       lineWidth = 0;
-                unsigned int       wordCount = 0;
-                while (iss >> word)
-                {
-
-                    // Determine word image width
-                    unsigned int wordWidth = 0;
-                    for (unsigned int i = 0; i < word.size( ); ++i)
-                    {
-                        Font::GlyphInfo glyph;
-                        if (font->getRect( word[i], glyph) )
-                        {
-                            wordWidth += static_cast<int>( glyph.advance * scale );
-                        }
-                    }
-                    // Determine if the word will fit on the line
-                    if (width > 0 && (width + spaceWidth + wordWidth > imageMaxWidth))
-                    {
-                        text.push_back( line );
-                        textWords.push_back( wordCount );
-                        textWidth.push_back( lineWidth );
-                        textLast.push_back( false );
-                        line      = word;
-                        width     = wordWidth;
-                        lineWidth = wordWidth;
-                        wordCount = 1;
-                    }
-                    else
-                    {
-                        if (width == 0)
-                        {
-                            line  += word;
-                            width += wordWidth;
-                        }
-                        else
-                        {
-                            line  += " " + word;
-                            width += spaceWidth + wordWidth;
-                        }
-                        lineWidth += wordWidth;
-                        wordCount += 1;
-                    }
-                }
-                if (text_[l] == "" || line != "")
-                {
-                    text.push_back( line );
-                    textWords.push_back( wordCount );
-                    textWidth.push_back( lineWidth );
-                    textLast.push_back( true );
-                    width     = 0;
-                    lineWidth = 0;
-                    wordCount = 0;
-                }
-            }
+            // Reformat the text based on the image width; only redone when
+            // the text, font or box changed
+            layout_.wrap( text_, font, baseViewInfo.FontSize, imageMaxWidth );
+            const std::vector<TextLayout::Line> &text = layout_.getLines( );
+            unsigned int spaceWidth = layout_.getSpaceWidth( );
 
 
             // Print reformatted text
@@ -689,30 +613,31 @@ void ReloadableScrollingText::draw( )
                     break;
                 }
 
+                unsigned int textWords = static_cast<unsigned int>( text[l].words.size( ) );
+
                 // Define x coordinate
                 rect.x = static_cast<int>( xOrigin );
                 if (alignment_ == "right")
                 {
-                    rect.x = static_cast<int>( xOrigin + imageMaxWidth - textWidth[l] - (textWords[l] - 1) * spaceWidth * scale );
+                    rect.x = static_cast<int>( xOrigin + imageMaxWidth - text[l].width - (textWords - 1) * spaceWidth * scale );
                 }
                 if (alignment_ == "centered")
                 {
-                    rect.x = static_cast<int>( xOrigin + imageMaxWidth / 2 - textWidth[l] / 2 - (textWords[l] - 1) * spaceWidth * scale / 2 );
+                    rect.x = static_cast<int>( xOrigin + imageMaxWidth / 2 - text[l].width / 2 - (textWords - 1) * spaceWidth * scale / 2 );
                 }
 
-                std::istringstream iss(text[l]);
-                std::string        word;
-                unsigned int       wordCount = textWords[l];
-                unsigned int       spaceFill = static_cast<int>( imageMaxWidth ) - textWidth[l];
-                unsigned int       yAdvance  = static_cast<int>( font->getHeight( ) * scale );
-                while (iss >> word)
+                unsigned int wordCount = textWords;
+                unsigned int spaceFill = static_cast<int>( imageMaxWidth ) - text[l].width;
+                unsigned int yAdvance  = static_cast<int>( font->getHeight( ) * scale );
+                for (unsigned int w = 0; w < text[l].words.size( ); ++w)
                 {
+                    const std::string &word = text[l].words[w];
 
-                    for (unsigned int i = 0; i < word.size( ); ++i)
+                    for (unsigned int i = 0; i < word.size( ); )
                     {
                         Font::GlyphInfo glyph;
 
-                        if (font->getRect( word[i], glyph) && glyph.rect.h > 0)
+                        if (font->getRect( Utils::decodeUtf8( word, i ), glyph) && glyph.rect.h > 0)
                         {
                             SDL_Rect charRect = glyph.rect;
                             rect.h   = static_cast<int>( charRect.h * scale );
@@ -739,7 +664,7 @@ void ReloadableScrollingText::draw( )
                                 }
                                 if (rect.h > 0)
                                 {
-                                    SDL::renderCopy(t, baseViewInfo.Alpha, &charRect, &rect, baseViewInfo, page.getLayoutWidth(baseViewInfo.Monitor), page.getLayoutHeight(baseViewInfo.Monitor));
+                                    batch_.add( glyph.texture, charRect, rect );
                                 }
                             }
                             rect.x += static_cast<int>( glyph.advance * scale );
@@ -748,7 +673,7 @@ void ReloadableScrollingText::draw( )
 
                     // Print justified
                     wordCount -= 1;
-                    if (wordCount > 0 && !textLast[l] && alignment_ == "justified")
+                    if (wordCount > 0 && !text[l].last && alignment_ == "justified")
                     {
                         unsigned int advance = static_cast<int>( spaceFill / wordCount );
                         spaceFill -= advance;
@@ -761,7 +686,7 @@ void ReloadableScrollingText::draw( )
                 }
 
                 // Handle scrolling of empty lines
-                if (text[l] == "")
+                if (text[l].words.empty( ))
                 {
                     Font::GlyphInfo glyph;
 
@@ -795,5 +720,15 @@ void ReloadableScrollingText::draw( )
             }
 
         }
+
+        // glyphs on the pages of a cached layout were not looked up again,
+        // so tell the font those pages are still in use
+        const std::vector<unsigned int> &pages = layout_.getPages( );
+        for (unsigned int i = 0; i < pages.size( ); ++i)
+        {
+            font->touch( pages[i] );
+        }
+
+        batch_.draw( baseViewInfo.Alpha, baseViewInfo, page.getLayoutWidth(baseViewInfo.Monitor), page.getLayoutHeight(baseViewInfo.Monitor) );
     }
 }
@@ -16,6 +16,9 @@
 #pragma once
 #include "Component.h"
 #include "../../Collection/Item.h"
+#include "../../Database/Configuration.h"
+#include "../TextBatch.h"
+#include "../TextLayout.h"
 #include <SDL2/SDL.h>
 #include <vector>
 #include <string>
@@ -37,10 +40,14 @@ private:
     void reloadTexture( );
     void loadText( std::string collection, std::string type, std::string basename, std::string filepath, bool systemMode );
     Configuration           &config_;
+    Configuration::Handle    currentCollectionSetting_;
+    Configuration::Handle    layoutSetting_;
     bool                     systemMode_;
     bool                     layoutMode_;
     bool                     menuMode_;
     Font                    *fontInst_;
+    TextBatch                batch_;
+    TextLayout               layout_;
     std::string              type_;
     std::string              textFormat_;
     std::string              singlePrefix_;
@@ -28,6 +28,7 @@
 ReloadableText::ReloadableText(std::string type, Page &page, Configuration &config, bool systemMode, Font *font, std::string layoutKey, std::string timeFormat, std::string textFormat, std::string singlePrefix, std::string singlePostfix, std::string pluralPrefix, std::string pluralPostfix)
     : Component(page)
     , config_(config)
+    , overwriteXMLSetting_(config.getHandle("overwriteXML"))
     , systemMode_(systemMode)
     , imageInst_(NULL)
     , type_(type)
@@ -297,7 +298,7 @@ void ReloadableText::ReloadTexture()
         }
 
         bool overwriteXML = false;
-        config_.getProperty( "overwriteXML", overwriteXML );
+        config_.getProperty( overwriteXMLSetting_, overwriteXML );
         if ( text == "" || overwriteXML ) // No text was found yet; check the info in stead
         {
             std::string text_tmp;
@@ -19,6 +19,7 @@
 #include "../Font.h"
 #include "../Page.h"
 #include "../../Collection/Item.h"
+#include "../../Database/Configuration.h"
 #include <SDL2/SDL.h>
 #include <string>
 
@@ -38,6 +39,7 @@ private:
     void ReloadTexture();
 
     Configuration &config_;
+    Configuration::Handle overwriteXMLSetting_;
     bool systemMode_;
     Text *imageInst_;
     std::string type_;
@@ -62,11 +62,17 @@ ScrollingList::ScrollingList( Configuration &c,
     , minScrollTime_( 0.500 )
     , scrollPeriod_( 0 )
     , config_( c )
+    , layoutSetting_( c.getHandle( "layout" ) )
+    , prevLetterSubToCurrentSetting_( c.getHandle( "prevLetterSubToCurrent" ) )
     , fontInst_( font )
     , layoutKey_( layoutKey )
     , imageType_( imageType )
     , videoType_( videoType )
     , items_( NULL )
+    , jumpIndexDirty_( true )
+    , prefetchAhead_( 0 )
+    , prefetchBehind_( 0 )
+    , scrollForward_( true )
 {
 }
 
@@ -84,10 +90,17 @@ ScrollingList::ScrollingList( const ScrollingList &copy )
     , minScrollTime_( copy.minScrollTime_ )
     , scrollPeriod_( copy.startScrollTime_ )
     , config_( copy.config_ )
+    , layoutSetting_( copy.layoutSetting_ )
+    , prevLetterSubToCurrentSetting_( copy.prevLetterSubToCurrentSetting_ )
     , fontInst_( copy.fontInst_ )
     , layoutKey_( copy.layoutKey_ )
     , imageType_( copy.imageType_ )
+    , videoType_( copy.videoType_ )
     , items_( NULL )
+    , jumpIndexDirty_( true )
+    , prefetchAhead_( copy.prefetchAhead_ )
+    , prefetchBehind_( copy.prefetchBehind_ )
+    , scrollForward_( true )
 {
     scrollPoints_ = NULL;
     tweenPoints_  = NULL;
@@ -111,10 +124,18 @@ ScrollingList::~ScrollingList( )
 
 void ScrollingList::setItems( std::vector<Item *> *items )
 {
+    clearPrefetch( );
+    letterIndex_.clear( );
+    subIndex_.clear( );
+    jumpIndexDirty_ = true;
     items_ = items;
     if ( items_ )
     {
         itemIndex_ = loopDecrement( 0, selectedOffsetIndex_, items_->size( ) );
+        if ( items_->size( ) > 0 )
+        {
+            updateJumpIndex( );
+        }
     }
 }
 
@@ -153,6 +174,7 @@ void ScrollingList::setMinScrollTime( float value )
 
 void ScrollingList::deallocateSpritePoints( )
 {
+    clearPrefetch( );
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         deallocateTexture( i );
@@ -189,11 +211,14 @@ void ScrollingList::allocateSpritePoints( )
         }
 
     }
+
+    updatePrefetch( );
 }
 
 
 void ScrollingList::destroyItems( )
 {
+    clearPrefetch( );
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         if ( components_.at( i ) )
@@ -312,60 +337,8 @@ void ScrollingList::letterChange( bool increment )
 
     if ( !items_ || items_->size( ) == 0 ) return;
 
-    Item       *startItem = items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) );
-    std::string startname = items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->lowercaseFullTitle( );
-
-    for ( unsigned int i = 0; i < items_->size( ); ++i )
-    {
-        unsigned int index = 0;
-        if ( increment )
-        {
-            index = loopIncrement( itemIndex_, i, items_->size( ) );
-        }
-        else
-        {
-            index = loopDecrement( itemIndex_, i, items_->size( ) );
-        }
-
-        std::string endname = items_->at( (index+selectedOffsetIndex_ ) % items_->size( ) )->lowercaseFullTitle( );
-
-        // check if we are changing characters from a-z, or changing from alpha character to non-alpha character
-        if ((isalpha(startname[0] ) ^ isalpha(endname[0] ) ) ||
-            (isalpha(startname[0] ) && isalpha(endname[0] ) && startname[0] != endname[0] ) )
-        {
-            itemIndex_ = index;
-            break;
-        }
-    }
-
-    if ( !increment ) // For decrement, find the first game of the new letter
-    {
-        bool prevLetterSubToCurrent = false;
-        config_.getProperty( "prevLetterSubToCurrent", prevLetterSubToCurrent );
-        if ( !prevLetterSubToCurrent || items_->at( (itemIndex_+1+selectedOffsetIndex_ ) % items_->size( ) ) == startItem )
-        {
-            startname = items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->lowercaseFullTitle( );
-
-            for ( unsigned int i = 0; i < items_->size( ); ++i )
-            {
-                unsigned int index = loopDecrement( itemIndex_, i, items_->size( ) );
-
-                std::string endname = items_->at( (index+selectedOffsetIndex_ ) % items_->size( ) )->lowercaseFullTitle( );
-
-                // check if we are changing characters from a-z, or changing from alpha character to non-alpha character
-                if ((isalpha(startname[0] ) ^ isalpha(endname[0] ) ) ||
-                    (isalpha(startname[0] ) && isalpha(endname[0] ) && startname[0] != endname[0] ) )
-                {
-                    itemIndex_ = loopIncrement( index,1,items_->size( ) );
-                    break;
-                }
-            }
-        }
-        else
-        {
-            itemIndex_ = loopIncrement( itemIndex_,1,items_->size( ) );
-        }
-    }
+    updateJumpIndex( );
+    jump( letterIndex_, increment );
 }
 
 
@@ -386,62 +359,101 @@ void ScrollingList::subChange( bool increment )
 
     if ( !items_ || items_->size( ) == 0 ) return;
 
-    Item       *startItem = items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) );
-    std::string startname = items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->lowercaseName( );
+    updateJumpIndex( );
+    jump( subIndex_, increment );
+}
 
-    for ( unsigned int i = 0; i < items_->size( ); ++i )
+
+// Moves to the next or previous change of jump class (letter or collection).
+// Going back lands on the first item of the previous class, or with
+// prevLetterSubToCurrent on the first item of the current one.
+void ScrollingList::jump( JumpIndex &index, bool increment )
+{
+    unsigned int size      = items_->size( );
+    unsigned int position  = (itemIndex_+selectedOffsetIndex_ ) % size;
+    Item        *startItem = items_->at( position );
+
+    if ( increment )
     {
-        unsigned int index = 0;
-        if ( increment )
+        itemIndex_ = loopIncrement( itemIndex_, index.stepsForward( position ), size );
+    }
+    else
+    {
+        itemIndex_ = loopDecrement( itemIndex_, index.stepsBackward( position ), size );
+    }
+
+    if ( !increment ) // For decrement, find the first game of the new letter or sub
+    {
+        bool prevLetterSubToCurrent = false;
+        config_.getProperty( prevLetterSubToCurrentSetting_, prevLetterSubToCurrent );
+        if ( !prevLetterSubToCurrent || items_->at( (itemIndex_+1+selectedOffsetIndex_ ) % size ) == startItem )
         {
-            index = loopIncrement( itemIndex_, i, items_->size( ) );
+            unsigned int steps = index.stepsBackward( (itemIndex_+selectedOffsetIndex_ ) % size );
+            if ( steps > 0 )
+            {
+                itemIndex_ = loopIncrement( loopDecrement( itemIndex_, steps, size ), 1, size );
+            }
         }
         else
         {
-            index = loopDecrement( itemIndex_, i, items_->size( ) );
+            itemIndex_ = loopIncrement( itemIndex_,1,size );
         }
+    }
+}
 
-        std::string endname = items_->at( (index+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->lowercaseName( );
 
-        if (startname != endname)
-        {
-            itemIndex_ = index;
-            break;
-        }
-    }
+// Playlists can change in place (favorites, last played) without a new
+// setItems; whoever changes them calls this so the jump indexes are rebuilt.
+void ScrollingList::itemsChanged( )
+{
+    jumpIndexDirty_ = true;
+}
+
 
-    if ( !increment ) // For decrement, find the first game of the new sub
+// The jump indexes are built lazily for the current list, and again after
+// setItems or itemsChanged.
+void ScrollingList::updateJumpIndex( )
+{
+    if ( !jumpIndexDirty_ && letterIndex_.size( ) == items_->size( ) )
     {
-        bool prevLetterSubToCurrent = false;
-        config_.getProperty( "prevLetterSubToCurrent", prevLetterSubToCurrent );
-        if ( !prevLetterSubToCurrent || items_->at( (itemIndex_+1+selectedOffsetIndex_ ) % items_->size( ) ) == startItem )
-        {
-            startname = items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->lowercaseName( );
+        return;
+    }
 
-            for ( unsigned int i = 0; i < items_->size( ); ++i )
-            {
-                unsigned int index = loopDecrement( itemIndex_, i, items_->size( ) );
+    std::vector<int> letters;
+    std::vector<int> subs;
+    std::map<std::string, int> subIds;
+    letters.reserve( items_->size( ) );
+    subs.reserve( items_->size( ) );
 
-                std::string endname = items_->at( (index+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->lowercaseName( );
+    for ( std::vector<Item *>::iterator it = items_->begin( ); it != items_->end( ); it++ )
+    {
+        letters.push_back( letterClass( *it ) );
 
-                if (startname != endname)
-                {
-                    itemIndex_ = loopIncrement( index,1,items_->size( ) );
-                    break;
-                }
-            }
-        }
-        else
+        std::map<std::string, int>::iterator sub = subIds.find( (*it)->collectionInfo->sortName );
+        if ( sub == subIds.end( ) )
         {
-            itemIndex_ = loopIncrement( itemIndex_,1,items_->size( ) );
+            sub = subIds.insert( std::make_pair( (*it)->collectionInfo->sortName, (int)subIds.size( ) ) ).first;
         }
+        subs.push_back( sub->second );
     }
+
+    letterIndex_.build( letters );
+    subIndex_.build( subs );
+    jumpIndexDirty_ = false;
+}
+
+
+// Letters a-z each form their own class; everything else is one class.
+int ScrollingList::letterClass( Item *item )
+{
+    unsigned char c = item->sortKey.empty( ) ? 0 : (unsigned char)item->sortKey[0];
+    return isalpha( c ) ? c : 0;
 }
 
 
 void ScrollingList::cfwLetterSubUp( )
 {
-    if (Utils::toLower( collectionName ) != items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->lowercaseName( ))
+    if (Utils::toLower( collectionName ) != items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->sortName)
         subChange( true );
     else
         letterChange( true );
@@ -450,10 +462,10 @@ void ScrollingList::cfwLetterSubUp( )
 
 void ScrollingList::cfwLetterSubDown( )
 {
-    if (Utils::toLower( collectionName ) != items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->lowercaseName( ))
+    if (Utils::toLower( collectionName ) != items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->sortName)
     {
         subChange( false );
-        if (Utils::toLower( collectionName ) == items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->lowercaseName( ))
+        if (Utils::toLower( collectionName ) == items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->sortName)
         {
             subChange( true );
             letterChange( false );
@@ -462,7 +474,7 @@ void ScrollingList::cfwLetterSubDown( )
     else
     {
         letterChange( false );
-        if (Utils::toLower( collectionName ) != items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->lowercaseName( ))
+        if (Utils::toLower( collectionName ) != items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->collectionInfo->sortName)
         {
             letterChange( true );
             subChange( false );
@@ -715,6 +727,25 @@ bool ScrollingList::allocateTexture( unsigned int index, Item *item )
 
     if ( index >= components_.size( ) ) return false;
 
+    Component *t = takePrefetched( item );
+
+    if ( !t )
+    {
+        t = createComponent( item );
+    }
+
+    if ( t )
+    {
+        components_.at( index ) = t;
+    }
+
+    return true;
+}
+
+
+Component *ScrollingList::createComponent( Item *item )
+{
+
     std::string imagePath;
     std::string videoPath;
 
@@ -724,7 +755,7 @@ bool ScrollingList::allocateTexture( unsigned int index, Item *item )
     VideoBuilder videoBuild;
 
     std::string layoutName;
-    config_.getProperty( "layout", layoutName );
+    config_.getProperty( layoutSetting_, layoutName );
 
     std::string typeLC = Utils::toLower( imageType_ );
 
@@ -766,122 +797,91 @@ bool ScrollingList::allocateTexture( unsigned int index, Item *item )
         names.push_back( item->score );
     names.push_back("default");
 
-    for ( unsigned int n = 0; n < names.size() && !t; ++n )
+    // check for video art; images are resolved by the image loader below
+    if ( videoType_ != "null" )
     {
-        // check collection path for art
-        if ( layoutMode_ )
-        {
-            if ( commonMode_ )
-                imagePath = Utils::combinePath(Configuration::absolutePath, "layouts", layoutName, "collections", "_common");
-            else
-                imagePath = Utils::combinePath( Configuration::absolutePath, "layouts", layoutName, "collections", collectionName );
-            imagePath = Utils::combinePath( imagePath, "medium_artwork", imageType_ );
-            videoPath = Utils::combinePath( imagePath, "medium_artwork", videoType_ );
-        }
-        else
-        {
-            if ( commonMode_ )
-            {
-                imagePath = Utils::combinePath(Configuration::absolutePath, "collections", "_common" );
-                imagePath = Utils::combinePath( imagePath, "medium_artwork", imageType_ );
-                videoPath = Utils::combinePath( imagePath, "medium_artwork", videoType_ );
-            }
-            else
-            {
-                config_.getMediaPropertyAbsolutePath( collectionName, imageType_, false, imagePath );
-                config_.getMediaPropertyAbsolutePath( collectionName, videoType_, false, videoPath );
-            }
-        }
-        if ( !t )
-        {
-            if ( videoType_ != "null" )
-            {
-                t = videoBuild.createVideo( videoPath, page, names[n], baseViewInfo.Monitor, false );
-            }
-            else
-            {
-                t = imageBuild.CreateImage( imagePath, page, names[n], baseViewInfo.Monitor );
-            }
-        }
-
-        // check sub-collection path for art
-        if ( !t && !commonMode_ )
+        for ( unsigned int n = 0; n < names.size() && !t; ++n )
         {
+            // check collection path for art
             if ( layoutMode_ )
             {
-                imagePath = Utils::combinePath( Configuration::absolutePath, "layouts", layoutName, "collections", item->collectionInfo->name );
-                imagePath = Utils::combinePath( imagePath, "medium_artwork", imageType_ );
-                videoPath = Utils::combinePath( imagePath, "medium_artwork", videoType_ );
+                if ( commonMode_ )
+                    videoPath = Utils::combinePath(Configuration::absolutePath, "layouts", layoutName, "collections", "_common");
+                else
+                    videoPath = Utils::combinePath( Configuration::absolutePath, "layouts", layoutName, "collections", collectionName );
+                videoPath = Utils::combinePath( videoPath, "medium_artwork", videoType_ );
             }
             else
             {
-                config_.getMediaPropertyAbsolutePath( item->collectionInfo->name, imageType_, false, imagePath );
-                config_.getMediaPropertyAbsolutePath( item->collectionInfo->name, videoType_, false, videoPath );
+                if ( commonMode_ )
+                {
+                    videoPath = Utils::combinePath(Configuration::absolutePath, "collections", "_common" );
+                    videoPath = Utils::combinePath( videoPath, "medium_artwork", videoType_ );
+                }
+                else
+                {
+                    config_.getMediaPropertyAbsolutePath( collectionName, videoType_, false, videoPath );
+                }
             }
-            if ( videoType_ != "null" )
+            t = videoBuild.createVideo( videoPath, page, names[n], baseViewInfo.Monitor, false );
+
+            // check sub-collection path for art
+            if ( !t && !commonMode_ )
             {
+                if ( layoutMode_ )
+                {
+                    videoPath = Utils::combinePath( Configuration::absolutePath, "layouts", layoutName, "collections", item->collectionInfo->name );
+                    videoPath = Utils::combinePath( videoPath, "medium_artwork", videoType_ );
+                }
+                else
+                {
+                    config_.getMediaPropertyAbsolutePath( item->collectionInfo->name, videoType_, false, videoPath );
+                }
                 t = videoBuild.createVideo( videoPath, page, names[n], baseViewInfo.Monitor, false );
             }
-            else
-            {
-                t = imageBuild.CreateImage( imagePath, page, names[n], baseViewInfo.Monitor );
-            }
         }
-    }
 
-    // check collection path for art based on system name
-    if ( !t )
-    {
-        if ( layoutMode_ )
-        {
-            if ( commonMode_ )
-                imagePath = Utils::combinePath(Configuration::absolutePath, "layouts", layoutName, "collections", "_common");
-            else
-                imagePath = Utils::combinePath( Configuration::absolutePath, "layouts", layoutName, "collections", item->name );
-            imagePath = Utils::combinePath( imagePath, "system_artwork" );
-            videoPath = imagePath;
-        }
-        else
+        // check collection path for art based on system name
+        if ( !t )
         {
-            if ( commonMode_ )
+            if ( layoutMode_ )
             {
-                imagePath = Utils::combinePath(Configuration::absolutePath, "collections", "_common" );
-                imagePath = Utils::combinePath( imagePath, "system_artwork" );
-                videoPath = imagePath;
+                if ( commonMode_ )
+                    videoPath = Utils::combinePath(Configuration::absolutePath, "layouts", layoutName, "collections", "_common");
+                else
+                    videoPath = Utils::combinePath( Configuration::absolutePath, "layouts", layoutName, "collections", item->name );
+                videoPath = Utils::combinePath( videoPath, "system_artwork" );
             }
             else
             {
-                config_.getMediaPropertyAbsolutePath( item->name, imageType_, true, imagePath );
-                config_.getMediaPropertyAbsolutePath( item->name, videoType_, true, videoPath );
+                if ( commonMode_ )
+                {
+                    videoPath = Utils::combinePath(Configuration::absolutePath, "collections", "_common" );
+                    videoPath = Utils::combinePath( videoPath, "system_artwork" );
+                }
+                else
+                {
+                    config_.getMediaPropertyAbsolutePath( item->name, videoType_, true, videoPath );
+                }
             }
-        }
-        if ( videoType_ != "null" )
-        {
             t = videoBuild.createVideo( videoPath, page, videoType_, baseViewInfo.Monitor, false );
         }
-        else
-        {
-            t = imageBuild.CreateImage( imagePath, page, imageType_, baseViewInfo.Monitor );
-        }
-    }
 
-    // check rom directory path for art
-    if ( !t )
-    {
-        if ( videoType_ != "null" )
+        // check rom directory path for art
+        if ( !t )
         {
             t = videoBuild.createVideo( item->filepath, page, videoType_, baseViewInfo.Monitor, false );
         }
-        else
-        {
-            t = imageBuild.CreateImage( item->filepath, page, imageType_, baseViewInfo.Monitor );
-        }
     }
 
-    // Check for fallback art in case no video could be found
-    if ( videoType_ != "null" && !t)
+    // Image art, or fallback art in case no video could be found. Only the
+    // candidate paths are built here; probing the disk and decoding is left
+    // to the image loader so scrolling never waits on it.
+    if ( !t )
     {
-        for ( unsigned int n = 0; n < names.size() && !t; ++n )
+        std::vector<std::string> prefixes;
+
+        for ( unsigned int n = 0; n < names.size(); ++n )
         {
             // check collection path for art
             if ( layoutMode_ )
@@ -890,7 +890,7 @@ bool ScrollingList::allocateTexture( unsigned int index, Item *item )
                     imagePath = Utils::combinePath(Configuration::absolutePath, "layouts", layoutName, "collections", "_common");
                 else
                     imagePath = Utils::combinePath( Configuration::absolutePath, "layouts", layoutName, "collections", collectionName );
-               imagePath = Utils::combinePath( imagePath, "medium_artwork", imageType_ );
+                imagePath = Utils::combinePath( imagePath, "medium_artwork", imageType_ );
             }
             else
             {
@@ -904,11 +904,10 @@ bool ScrollingList::allocateTexture( unsigned int index, Item *item )
                     config_.getMediaPropertyAbsolutePath( collectionName, imageType_, false, imagePath );
                 }
             }
-
-            t = imageBuild.CreateImage( imagePath, page, names[n], baseViewInfo.Monitor );
+            prefixes.push_back( Utils::combinePath( imagePath, names[n] ) );
 
             // check sub-collection path for art
-            if ( !t && !commonMode_ )
+            if ( !commonMode_ )
             {
                 if ( layoutMode_ )
                 {
@@ -919,57 +918,41 @@ bool ScrollingList::allocateTexture( unsigned int index, Item *item )
                 {
                     config_.getMediaPropertyAbsolutePath( item->collectionInfo->name, imageType_, false, imagePath );
                 }
-                t = imageBuild.CreateImage( imagePath, page, names[n], baseViewInfo.Monitor );
+                prefixes.push_back( Utils::combinePath( imagePath, names[n] ) );
             }
         }
 
         // check collection path for art based on system name
-        if ( !t )
+        if ( layoutMode_ )
         {
-            if ( layoutMode_ )
+            if ( commonMode_ )
+                imagePath = Utils::combinePath(Configuration::absolutePath, "layouts", layoutName, "collections", "_common");
+            else
+                imagePath = Utils::combinePath( Configuration::absolutePath, "layouts", layoutName, "collections", item->name );
+            imagePath = Utils::combinePath( imagePath, "system_artwork" );
+        }
+        else
+        {
+            if ( commonMode_ )
             {
-                if ( commonMode_ )
-                    imagePath = Utils::combinePath(Configuration::absolutePath, "layouts", layoutName, "collections", "_common");
-                else
-                    imagePath = Utils::combinePath( Configuration::absolutePath, "layouts", layoutName, "collections", item->name );
+                imagePath = Utils::combinePath(Configuration::absolutePath, "collections", "_common" );
                 imagePath = Utils::combinePath( imagePath, "system_artwork" );
             }
             else
             {
-                if ( commonMode_ )
-                {
-                    imagePath = Utils::combinePath(Configuration::absolutePath, "collections", "_common" );
-                    imagePath = Utils::combinePath( imagePath, "system_artwork" );
-                }
-                else
-                {
-                    config_.getMediaPropertyAbsolutePath( item->name, imageType_, true, imagePath );
-                }
-            }
-            if ( !t )
-            {
-                t = imageBuild.CreateImage( imagePath, page, imageType_, baseViewInfo.Monitor );
+                config_.getMediaPropertyAbsolutePath( item->name, imageType_, true, imagePath );
             }
         }
-        // check rom directory path for art
-        if ( !t )
-        {
-            t = imageBuild.CreateImage( item->filepath, page, imageType_, baseViewInfo.Monitor );
-        }
-
-    }
+        prefixes.push_back( Utils::combinePath( imagePath, imageType_ ) );
 
-    if ( !t )
-    {
-        t = new Text(item->title, page, fontInst_, baseViewInfo.Monitor );
-    }
+        // check rom directory path for art
+        prefixes.push_back( Utils::combinePath( item->filepath, imageType_ ) );
 
-    if ( t )
-    {
-        components_.at( index ) = t;
+        // the title is shown until the art is loaded, or if there is none
+        t = imageBuild.CreateAsyncImage( prefixes, page, new Text(item->title, page, fontInst_, baseViewInfo.Monitor ), baseViewInfo.Monitor );
     }
 
-    return true;
+    return t;
 }
 
 
@@ -983,6 +966,128 @@ void ScrollingList::deallocateTexture( unsigned int index )
         s->freeGraphicsMemory(  );
 }
 
+void ScrollingList::setPrefetch( unsigned int ahead, unsigned int behind )
+{
+    prefetchAhead_  = ahead;
+    prefetchBehind_ = behind;
+}
+
+
+// Prefetching only warms image art; video components are too heavy to
+// keep around off screen.
+bool ScrollingList::isPrefetching( )
+{
+    return (prefetchAhead_ > 0 || prefetchBehind_ > 0) && videoType_ == "null";
+}
+
+
+Component *ScrollingList::takePrefetched( Item *item )
+{
+    std::map<Item *, Component *>::iterator it = prefetch_.find( item );
+
+    if ( it == prefetch_.end( ) ) return NULL;
+
+    Component *c = it->second;
+    prefetch_.erase( it );
+
+    return c;
+}
+
+
+// Release the component at index once its item has scrolled out of view.
+// With prefetching it is kept, art and all, in case the list scrolls back.
+void ScrollingList::retireTexture( unsigned int index, Item *item )
+{
+    if ( components_.size( ) <= index ) return;
+
+    Component *c = components_.at( index );
+    components_.at( index ) = NULL;
+
+    if ( !c ) return;
+
+    if ( isPrefetching( ) && prefetch_.find( item ) == prefetch_.end( ) )
+    {
+        prefetch_[item] = c;
+    }
+    else
+    {
+        c->freeGraphicsMemory( );
+        delete c;
+    }
+}
+
+
+// Make sure the items just beyond both edges of the visible window have
+// their art loading, with prefetchAhead items on the side we are scrolling
+// towards and prefetchBehind items on the other side. Anything else is evicted.
+void ScrollingList::updatePrefetch( )
+{
+    if ( !isPrefetching( ) || !items_ || items_->size( ) == 0 || components_.size( ) == 0 )
+    {
+        clearPrefetch( );
+        return;
+    }
+
+    unsigned int size      = items_->size( );
+    unsigned int visible   = components_.size( );
+    unsigned int available = (size > visible) ? size - visible : 0;
+    unsigned int forward   = scrollForward_ ? prefetchAhead_  : prefetchBehind_;
+    unsigned int backward  = scrollForward_ ? prefetchBehind_ : prefetchAhead_;
+
+    if ( forward > available )
+        forward = available;
+    if ( backward > available - forward )
+        backward = available - forward;
+
+    // the side we are scrolling towards is queued first, nearest item first
+    std::vector<Item *> wanted;
+    std::vector<Item *> opposite;
+    for ( unsigned int i = 0; i < forward; ++i )
+    {
+        Item *item = items_->at( loopIncrement( itemIndex_, visible + i, size ) );
+        (scrollForward_ ? wanted : opposite).push_back( item );
+    }
+    for ( unsigned int i = 0; i < backward; ++i )
+    {
+        Item *item = items_->at( loopDecrement( itemIndex_, i + 1, size ) );
+        (scrollForward_ ? opposite : wanted).push_back( item );
+    }
+    wanted.insert( wanted.end( ), opposite.begin( ), opposite.end( ) );
+
+    std::map<Item *, Component *> prefetch;
+    for ( unsigned int i = 0; i < wanted.size( ); ++i )
+    {
+        Item *item = wanted[i];
+
+        if ( prefetch.find( item ) != prefetch.end( ) ) continue;
+
+        Component *c = takePrefetched( item );
+        if ( !c )
+        {
+            c = createComponent( item );
+        }
+        prefetch[item] = c;
+    }
+
+    clearPrefetch( );
+    prefetch_.swap( prefetch );
+}
+
+
+void ScrollingList::clearPrefetch( )
+{
+    for ( std::map<Item *, Component *>::iterator it = prefetch_.begin( ); it != prefetch_.end( ); ++it )
+    {
+        if ( it->second )
+        {
+            it->second->freeGraphicsMemory( );
+            delete it->second;
+        }
+    }
+    prefetch_.clear( );
+}
+
+
 void ScrollingList::draw(  )
 {
     //todo: Poor design implementation.
@@ -1003,6 +1108,18 @@ void ScrollingList::draw( unsigned int layer )
 }
 
 
+// Append the item components to the draw list of their layer, keeping their
+// order within the list.
+void ScrollingList::addToLayers( std::vector<Component *> *layers, unsigned int numLayers )
+{
+    for ( unsigned int i = 0; i < components_.size(  ); ++i )
+    {
+        Component *c = components_[i];
+        if ( c && c->baseViewInfo.Layer < numLayers ) layers[c->baseViewInfo.Layer].push_back( c );
+    }
+}
+
+
 bool ScrollingList::isIdle(  )
 {
     if ( !Component::isIdle(  ) ) return false;
@@ -1060,18 +1177,22 @@ void ScrollingList::scroll( bool forward )
     }
 
     // Replace the item that's scrolled out
+    scrollForward_ = forward;
+
     if ( forward )
     {
         Item *i    = items_->at( loopIncrement( itemIndex_, scrollPoints_->size(  ), items_->size(  ) ) );
+        Item *out  = items_->at( itemIndex_ );
         itemIndex_ = loopIncrement( itemIndex_, 1, items_->size(  ) );
-        deallocateTexture( 0 );
+        retireTexture( 0, out );
         allocateTexture( 0, i );
     }
     else
     {
         Item *i    = items_->at( loopDecrement( itemIndex_, 1, items_->size(  ) ) );
+        Item *out  = items_->at( loopIncrement( itemIndex_, scrollPoints_->size(  ) - 1, items_->size(  ) ) );
         itemIndex_ = loopDecrement( itemIndex_, 1, items_->size(  ) );
-        deallocateTexture( loopDecrement( 0, 1, components_.size(  ) ) );
+        retireTexture( loopDecrement( 0, 1, components_.size(  ) ), out );
         allocateTexture( loopDecrement( 0, 1, components_.size(  ) ), i );
     }
 
@@ -1121,5 +1242,7 @@ void ScrollingList::scroll( bool forward )
         }
     }
 
+    updatePrefetch( );
+
     return;
 }
@@ -17,11 +17,13 @@
 
 
 #include <vector>
+#include <map>
 #include "Component.h"
 #include "../Animate/Tween.h"
 #include "../Page.h"
 #include "../ViewInfo.h"
 #include "../../Database/Configuration.h"
+#include "../../Collection/JumpIndex.h"
 #include <SDL2/SDL.h>
 
 
@@ -64,6 +66,7 @@ public:
     bool allocateTexture( unsigned int index, Item *i );
     void deallocateTexture( unsigned int index );
     void setItems( std::vector<Item *> *items );
+    void itemsChanged( );
     void destroyItems( );
     void setPoints( std::vector<ViewInfo *> *scrollPoints, std::vector<AnimationEvents *> *tweenPoints );
     unsigned int getSelectedIndex( );
@@ -92,9 +95,11 @@ public:
     void update( float dt );
     void draw( );
     void draw( unsigned int layer );
+    void addToLayers( std::vector<Component *> *layers, unsigned int numLayers );
     void setScrollAcceleration( float value );
     void setStartScrollTime( float value );
     void setMinScrollTime( float value );
+    void setPrefetch( unsigned int ahead, unsigned int behind );
     bool horizontalScroll;
     void deallocateSpritePoints( );
     void allocateSpritePoints( );
@@ -104,7 +109,16 @@ public:
 
 private:
 
+    Component *createComponent( Item *item );
+    Component *takePrefetched( Item *item );
+    void retireTexture( unsigned int index, Item *item );
+    bool isPrefetching( );
+    void updatePrefetch( );
+    void clearPrefetch( );
     void resetTweens( Component *c, AnimationEvents *sets, ViewInfo *currentViewInfo, ViewInfo *nextViewInfo, double scrollTime );
+    void jump( JumpIndex &index, bool increment );
+    void updateJumpIndex( );
+    static int letterClass( Item *item );
     unsigned int loopIncrement( unsigned int offset, unsigned int i, unsigned int size );
     unsigned int loopDecrement( unsigned int offset, unsigned int i, unsigned int size );
 
@@ -123,6 +137,8 @@ private:
     float scrollPeriod_;
 
     Configuration &config_;
+    Configuration::Handle layoutSetting_;
+    Configuration::Handle prevLetterSubToCurrentSetting_;
     Font          *fontInst_;
     std::string    layoutKey_;
     std::string    imageType_;
@@ -131,4 +147,15 @@ private:
     std::vector<Item *>     *items_;
     std::vector<Component *> components_;
 
+    // letter and collection boundaries of items_, for letterChange and subChange
+    JumpIndex                letterIndex_;
+    JumpIndex                subIndex_;
+    bool                     jumpIndexDirty_;
+
+    // art for the items just outside the visible window, see updatePrefetch
+    unsigned int                  prefetchAhead_;
+    unsigned int                  prefetchBehind_;
+    bool                          scrollForward_;
+    std::map<Item *, Component *> prefetch_;
+
 };
@@ -72,8 +72,6 @@ void Text::draw( )
     else                     // If not, use the general font settings
       font = fontInst_;
 
-    SDL_Texture *t = font->getTexture( );
-
     float imageHeight = 0;
     float imageWidth = 0;
     float imageMaxWidth = 0;
@@ -89,28 +87,16 @@ void Text::draw( )
     imageHeight = (float)font->getHeight( );
     float scale = (float)baseViewInfo.FontSize / (float)imageHeight;
 
-    unsigned int textIndexMax = 0;
+    // only measures the text again when it, the font or the box changed
+    layout_.layoutLine( textData_, font, baseViewInfo.FontSize, imageMaxWidth );
+    imageWidth = layout_.getWidth( );
 
-    // determine image width
-    for ( unsigned int i = 0; i < textData_.size( ); ++i )
+    // replaying the layout skips the glyph lookups, so tell the font its
+    // pages are still in use
+    const std::vector<unsigned int> &pages = layout_.getPages( );
+    for ( unsigned int i = 0; i < pages.size( ); ++i )
     {
-        Font::GlyphInfo glyph;
-        if ( font->getRect( textData_[i], glyph ) )
-        {
-            if ( glyph.minX < 0 )
-            {
-                imageWidth += glyph.minX;
-            }
-
-            if ( (imageWidth + glyph.advance)*scale > imageMaxWidth )
-            {
-                break;
-            }
-
-            textIndexMax = i;
-            imageWidth  += glyph.advance;
-        }
-
+        font->touch( pages[i] );
     }
 
     float oldWidth       = baseViewInfo.Width;
@@ -131,37 +117,15 @@ void Text::draw( )
     baseViewInfo.ImageWidth  = oldImageWidth;
     baseViewInfo.ImageHeight = oldImageHeight;
 
+    const std::vector<TextLayout::Glyph> &glyphs = layout_.getGlyphs( );
 
-    SDL_Rect rect;
-    rect.x = static_cast<int>( xOrigin );
-
-    for ( unsigned int i = 0; i <= textIndexMax; ++i )
+    batch_.begin( );
+    for ( unsigned int i = 0; i < glyphs.size( ); ++i )
     {
-        Font::GlyphInfo glyph;
-
-        if ( font->getRect(textData_[i], glyph) && glyph.rect.h > 0 )
-        {
-            SDL_Rect charRect = glyph.rect;
-            float h = static_cast<float>( charRect.h * scale );
-            float w = static_cast<float>( charRect.w * scale );
-            rect.h = static_cast<int>( h );
-            rect.w = static_cast<int>( w );
-            rect.y = static_cast<int>( yOrigin );
-
-            if(glyph.minX < 0)
-            {
-                rect.x += static_cast<int>( (float)(glyph.minX) * scale );
-            }
-            if ( font->getAscent( ) < glyph.maxY )
-            {
-                rect.y += static_cast<int>( (font->getAscent( ) - glyph.maxY)*scale );
-            }
-
-
-            SDL::renderCopy( t, baseViewInfo.Alpha, &charRect, &rect, baseViewInfo, page.getLayoutWidth(baseViewInfo.Monitor), page.getLayoutHeight(baseViewInfo.Monitor) );
-
-            rect.x += static_cast<int>( glyph.advance * scale );
-
-        }
+        SDL_Rect rect = glyphs[i].dest;
+        rect.x += static_cast<int>( xOrigin );
+        rect.y += static_cast<int>( yOrigin );
+        batch_.add( glyphs[i].texture, glyphs[i].src, rect );
     }
+    batch_.draw( baseViewInfo.Alpha, baseViewInfo, page.getLayoutWidth(baseViewInfo.Monitor), page.getLayoutHeight(baseViewInfo.Monitor) );
 }
@@ -18,6 +18,8 @@
 
 #include "Component.h"
 #include "../Page.h"
+#include "../TextBatch.h"
+#include "../TextLayout.h"
 #include <SDL2/SDL.h>
 #include <vector>
 
@@ -41,4 +43,6 @@ public:
 private:
     std::string textData_;
     Font       *fontInst_;
+    TextBatch   batch_;
+    TextLayout  layout_;
 };
@@ -15,6 +15,7 @@
  */
 
 #include "VideoBuilder.h"
+#include "../../Utility/MediaIndex.h"
 #include "../../Utility/Utils.h"
 #include "../../Utility/Log.h"
 #include "../../Video/VideoFactory.h"
@@ -42,7 +43,7 @@ VideoComponent * VideoBuilder::createVideo(std::string path, Page &page, std::st
     std::string prefix = Utils::combinePath(path, name);
     std::string file;
 
-    if(Utils::findMatchingFile(prefix, extensions, file))
+    if(MediaIndex::findMatchingFile(prefix, extensions, file))
     {
         IVideo *video = factory_.createVideo( monitor, isTypeVideo, numLoops );
 
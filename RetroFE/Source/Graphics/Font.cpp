@@ -23,6 +23,11 @@
 
 Font::Font(std::string fontPath, int fontSize, SDL_Color color, int monitor)
     : texture(NULL)
+    , height(0)
+    , ascent(0)
+    , font_(NULL)
+    , useCount_(0)
+    , generation_(0)
     , fontPath_(fontPath)
     , fontSize_(fontSize)
     , color_(color)
@@ -40,6 +45,22 @@ SDL_Texture *Font::getTexture()
     return texture;
 }
 
+// Mark a page as used without looking up its glyphs, for text drawn from a
+// cached layout, so the page is not the one emptied when room is needed
+void Font::touch(unsigned int page)
+{
+    if(page < pages_.size())
+    {
+        pages_[page]->lastUsed = ++useCount_;
+    }
+}
+
+// Changes whenever glyphs move, so cached layouts know to look them up again
+unsigned int Font::getGeneration()
+{
+    return generation_;
+}
+
 int Font::getHeight()
 {
     return height;
@@ -50,13 +71,11 @@ int Font::getAscent()
 }
 bool Font::getRect(unsigned int charCode, GlyphInfo &glyph)
 {
-    std::map<unsigned int, GlyphInfoBuild *>::iterator it = atlas.find(charCode);
+    const GlyphInfo *info = getGlyph(charCode);
 
-    if(it != atlas.end())
+    if(info)
     {
-        GlyphInfoBuild *info = it->second;
-
-        glyph = info->glyph;
+        glyph = *info;
 
         return true;
     }
@@ -83,6 +102,7 @@ bool Font::initialize()
     height = TTF_FontHeight(font);
     ascent = TTF_FontAscent(font);
 
+    std::vector<GlyphInfoBuild *> atlas;
     for(unsigned short int i = 32; i < 128; ++i)
     {
         GlyphInfoBuild *info = new GlyphInfoBuild;
@@ -107,7 +127,7 @@ bool Font::initialize()
         info->glyph.rect.h = info->surface->h;
         info->glyph.rect.x = x;
         info->glyph.rect.y = atlasHeight;
-        atlas[i] = info;
+        atlas.push_back(info);
 
         x += info->glyph.rect.w;
         y = (y > info->glyph.rect.h) ? y : info->glyph.rect.h;
@@ -133,10 +153,9 @@ bool Font::initialize()
 #endif
 
     SDL_Surface *atlasSurface = SDL_CreateRGBSurface(0, atlasWidth, atlasHeight, 32, rmask, gmask, bmask, amask);
-    std::map<unsigned int, GlyphInfoBuild *>::iterator it;
-    for(it = atlas.begin(); it != atlas.end(); it++)
+    for(std::vector<GlyphInfoBuild *>::iterator it = atlas.begin(); it != atlas.end(); it++)
     {
-        GlyphInfoBuild *info = it->second;
+        GlyphInfoBuild *info = *it;
         SDL_BlitSurface(info->surface, NULL, atlasSurface, &info->glyph.rect);
         SDL_FreeSurface(info->surface);
         info->surface = NULL;
@@ -148,31 +167,232 @@ bool Font::initialize()
     SDL_FreeSurface(atlasSurface);
     SDL_UnlockMutex(SDL::getMutex());
 
-    TTF_CloseFont(font);
+    // the baked characters make up the first page, which is full and never
+    // reused
+    Page *page = new Page;
+    page->id        = 0;
+    page->texture   = texture;
+    page->width     = atlasWidth;
+    page->height    = atlasHeight;
+    page->x         = atlasWidth;
+    page->y         = atlasHeight;
+    page->rowHeight = 0;
+    page->lastUsed  = 0;
+    pages_.push_back(page);
+
+    for(unsigned int i = 0; i < atlas.size(); ++i)
+    {
+        unsigned int code = 32 + i;
+        Glyph &glyph = getEntry(code);
+        glyph.info         = atlas[i]->glyph;
+        glyph.info.texture = texture;
+        glyph.info.page    = page->id;
+        glyph.page         = page;
+        page->codes.push_back(code);
+        delete atlas[i];
+    }
+
+    // kept open to rasterize other characters when they are first drawn
+    font_ = font;
 
     return true;
 }
 
 
+Font::Glyph &Font::getEntry(unsigned int charCode)
+{
+    unsigned int block = charCode >> 8;
+
+    if(glyphs_.size() <= block) glyphs_.resize(block + 1);
+    if(glyphs_[block].empty()) glyphs_[block].resize(256);
 
-void Font::deInitialize()
+    return glyphs_[block][charCode & 0xFF];
+}
+
+
+const Font::GlyphInfo *Font::loadGlyph(unsigned int charCode)
+{
+    // control characters were never drawn
+    if(!font_ || charCode < 32 || (charCode >= 0x7F && charCode < 0xA0) || charCode > 0x10FFFF) return NULL;
+
+    Glyph &glyph = getEntry(charCode);
+
+    SDL_Surface *surface = NULL;
+    GlyphInfo info;
+    memset(&info, 0, sizeof(info));
+    color_.a = 255;
+
+#if SDL_TTF_MAJOR_VERSION > 2 || (SDL_TTF_MAJOR_VERSION == 2 && (SDL_TTF_MINOR_VERSION > 0 || SDL_TTF_PATCHLEVEL >= 18))
+    if(TTF_GlyphIsProvided32(font_, charCode))
+    {
+        surface = TTF_RenderGlyph32_Blended(font_, charCode, color_);
+        TTF_GlyphMetrics32(font_, charCode, &info.minX, &info.maxX, &info.minY, &info.maxY, &info.advance);
+    }
+#else
+    if(charCode <= 0xFFFF && TTF_GlyphIsProvided(font_, static_cast<Uint16>(charCode)))
+    {
+        surface = TTF_RenderGlyph_Blended(font_, static_cast<Uint16>(charCode), color_);
+        TTF_GlyphMetrics(font_, static_cast<Uint16>(charCode), &info.minX, &info.maxX, &info.minY, &info.maxY, &info.advance);
+    }
+#endif
+
+    if(!surface)
+    {
+        glyph.missing = true;
+        return NULL;
+    }
+
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(surface);
+
+    SDL_LockMutex(SDL::getMutex());
+    Page *page = converted ? allocate(converted->w, converted->h, info.rect) : NULL;
+    if(page)
+    {
+        SDL_UpdateTexture(page->texture, &info.rect, converted->pixels, converted->pitch);
+    }
+    SDL_UnlockMutex(SDL::getMutex());
+
+    if(converted) SDL_FreeSurface(converted);
+
+    if(!page)
+    {
+        glyph.missing = true;
+        return NULL;
+    }
+
+    info.texture   = page->texture;
+    info.page      = page->id;
+    glyph.info     = info;
+    glyph.page     = page;
+    page->lastUsed = ++useCount_;
+    page->codes.push_back(charCode);
+
+    return &glyph.info;
+}
+
+
+// Find room for a glyph, adding a page or emptying the least recently used
+// one when the others are full. Called with the SDL mutex held.
+Font::Page *Font::allocate(int width, int height, SDL_Rect &rect)
 {
-    if(texture)
+    if(width + PADDING > PAGE_SIZE || height + PADDING > PAGE_SIZE) return NULL;
+
+    Page *page = NULL;
+
+    for(unsigned int i = 1; i < pages_.size() && !page; ++i)
+    {
+        Page *p = pages_[i];
+        int x = p->x;
+        int y = p->y;
+        int rowHeight = p->rowHeight;
+
+        if(x + width + PADDING > p->width)
+        {
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+        if(y + height + PADDING <= p->height)
+        {
+            p->x = x;
+            p->y = y;
+            p->rowHeight = rowHeight;
+            page = p;
+        }
+    }
+
+    if(!page && pages_.size() <= MAX_PAGES)
     {
-        SDL_LockMutex(SDL::getMutex());
-        SDL_DestroyTexture(texture);
-        texture = NULL;
-        SDL_UnlockMutex(SDL::getMutex());
+        SDL_Texture *t = SDL_CreateTexture(SDL::getRenderer(monitor_), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE);
+        if(t)
+        {
+            SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+
+            // start transparent so filtering never picks up stray pixels
+            // next to a glyph
+            std::vector<Uint32> pixels(PAGE_SIZE * PAGE_SIZE, 0);
+            SDL_UpdateTexture(t, NULL, &pixels[0], PAGE_SIZE * sizeof(Uint32));
+
+            page = new Page;
+            page->id        = static_cast<unsigned int>(pages_.size());
+            page->texture   = t;
+            page->width     = PAGE_SIZE;
+            page->height    = PAGE_SIZE;
+            page->x         = 0;
+            page->y         = 0;
+            page->rowHeight = 0;
+            page->lastUsed  = 0;
+            pages_.push_back(page);
+        }
+    }
+
+    if(!page && pages_.size() > 1)
+    {
+        page = pages_[1];
+        for(unsigned int i = 2; i < pages_.size(); ++i)
+        {
+            if(pages_[i]->lastUsed < page->lastUsed) page = pages_[i];
+        }
+        clearPage(page);
     }
 
-    std::map<unsigned int, GlyphInfoBuild *>::iterator atlasIt = atlas.begin();
-    while(atlasIt != atlas.end())
+    if(!page) return NULL;
+
+    rect.x = page->x;
+    rect.y = page->y;
+    rect.w = width;
+    rect.h = height;
+
+    page->x += width + PADDING;
+    page->rowHeight = (page->rowHeight > height + PADDING) ? page->rowHeight : height + PADDING;
+
+    return page;
+}
+
+
+// Forget the glyphs on a page so it can be filled again
+void Font::clearPage(Page *page)
+{
+    for(unsigned int i = 0; i < page->codes.size(); ++i)
     {
-        delete atlasIt->second;
-        atlas.erase(atlasIt);
-        atlasIt = atlas.begin();
+        Glyph &glyph = getEntry(page->codes[i]);
+        glyph.page = NULL;
     }
+    page->codes.clear();
+    page->x = 0;
+    page->y = 0;
+    page->rowHeight = 0;
+
+    // new glyphs won't line up with the old ones, so wipe the old pixels
+    // that would otherwise show through the padding
+    std::vector<Uint32> pixels(page->width * page->height, 0);
+    SDL_UpdateTexture(page->texture, NULL, &pixels[0], page->width * sizeof(Uint32));
 
+    generation_++;
 }
 
 
+
+void Font::deInitialize()
+{
+    SDL_LockMutex(SDL::getMutex());
+    for(unsigned int i = 0; i < pages_.size(); ++i)
+    {
+        if(pages_[i]->texture) SDL_DestroyTexture(pages_[i]->texture);
+        delete pages_[i];
+    }
+    pages_.clear();
+    texture = NULL;
+    SDL_UnlockMutex(SDL::getMutex());
+
+    glyphs_.clear();
+
+    if(font_)
+    {
+        TTF_CloseFont(font_);
+        font_ = NULL;
+    }
+
+    generation_++;
+}
@@ -16,9 +16,15 @@
 #pragma once
 
 #include <SDL2/SDL.h>
-#include <map>
+#include <SDL2/SDL_ttf.h>
 #include <string>
+#include <vector>
 
+// A font rendered into texture atlas pages. The printable ASCII characters
+// are baked into the first page when the font is initialized; any other
+// character is rasterized into one of a few extra pages the first time it is
+// drawn. When those pages are full, the least recently used one is emptied
+// and reused, so memory stays proportional to the characters in use.
 class Font
 {
 public:
@@ -30,6 +36,8 @@ public:
         int maxY;
         int advance;
         SDL_Rect rect;
+        SDL_Texture *texture; // atlas page holding the glyph
+        unsigned int page;    // id of that page, see touch()
     };
 
     Font(std::string fontPath, int fontSize, SDL_Color color, int monitor);
@@ -38,20 +46,71 @@ public:
     void deInitialize();
     SDL_Texture *getTexture();
     bool getRect(unsigned int charCode, GlyphInfo &glyph);
+    const GlyphInfo *getGlyph(unsigned int charCode)
+    {
+        unsigned int block = charCode >> 8;
+        if(block < glyphs_.size() && !glyphs_[block].empty())
+        {
+            Glyph &glyph = glyphs_[block][charCode & 0xFF];
+            if(glyph.page)
+            {
+                glyph.page->lastUsed = ++useCount_;
+                return &glyph.info;
+            }
+            if(glyph.missing) return NULL;
+        }
+        return loadGlyph(charCode);
+    }
+    void touch(unsigned int page);
+    unsigned int getGeneration();
     int getHeight();
     int getAscent();
 
 private:
+    static const int          PAGE_SIZE = 512;
+    static const unsigned int MAX_PAGES = 8; // besides the first page
+    static const int          PADDING   = 1;
+
+    struct Page
+    {
+        unsigned int id; // index in pages_
+        SDL_Texture *texture;
+        int width;
+        int height;
+        int x; // next free spot, filled row by row
+        int y;
+        int rowHeight;
+        Uint64 lastUsed;
+        std::vector<unsigned int> codes; // characters stored on the page
+    };
+
+    struct Glyph
+    {
+        Glyph() : page(NULL), missing(false) {}
+        GlyphInfo info;
+        Page *page;   // NULL until rasterized
+        bool missing; // the font has no glyph for this character
+    };
+
     struct GlyphInfoBuild
     {
         Font::GlyphInfo glyph;
         SDL_Surface *surface;
     };
 
+    Glyph &getEntry(unsigned int charCode);
+    const GlyphInfo *loadGlyph(unsigned int charCode);
+    Page *allocate(int width, int height, SDL_Rect &rect);
+    void clearPage(Page *page);
+
     SDL_Texture *texture;
     int height;
     int ascent;
-    std::map<unsigned int, GlyphInfoBuild *> atlas;
+    TTF_Font *font_;
+    std::vector< std::vector<Glyph> > glyphs_; // blocks of 256 characters, created on first use
+    std::vector<Page *> pages_;               // pages_[0] holds the baked characters
+    Uint64 useCount_;
+    unsigned int generation_;
     std::string fontPath_;
     int fontSize_;
     SDL_Color color_;
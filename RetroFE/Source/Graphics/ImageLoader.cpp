@@ -0,0 +1,248 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ImageLoader.h"
+#include "TextureCache.h"
+#include "../Utility/MediaIndex.h"
+#include "../Utility/Log.h"
+#include <SDL2/SDL_image.h>
+
+struct ImageLoader::Request
+{
+    std::vector<std::string> prefixes;
+    std::vector<std::string> extensions;
+    int                      monitor;
+    std::string              file;
+    SDL_Surface             *surface;
+    RequestState             state;
+    bool                     released;
+};
+
+std::vector<SDL_Thread *> ImageLoader::threads_;
+std::list<ImageLoader::Request *> ImageLoader::queue_;
+SDL_mutex *ImageLoader::mutex_ = NULL;
+SDL_cond *ImageLoader::cond_ = NULL;
+bool ImageLoader::running_ = false;
+
+
+bool ImageLoader::initialize(int numThreads)
+{
+    if(running_)
+    {
+        return true;
+    }
+
+    if(numThreads <= 0)
+    {
+        Logger::write(Logger::ZONE_INFO, "ImageLoader", "Loading artwork on the main thread");
+        return true;
+    }
+
+    mutex_ = SDL_CreateMutex();
+    cond_  = SDL_CreateCond();
+
+    if(!mutex_ || !cond_)
+    {
+        Logger::write(Logger::ZONE_ERROR, "ImageLoader", "Could not create synchronization primitives: " + std::string(SDL_GetError()));
+        deInitialize();
+        return false;
+    }
+
+    running_ = true;
+
+    for(int i = 0; i < numThreads; ++i)
+    {
+        SDL_Thread *thread = SDL_CreateThread(worker, "ImageLoader", NULL);
+        if(!thread)
+        {
+            Logger::write(Logger::ZONE_WARNING, "ImageLoader", "Could not create worker thread: " + std::string(SDL_GetError()));
+            break;
+        }
+        threads_.push_back(thread);
+    }
+
+    if(threads_.size() == 0)
+    {
+        deInitialize();
+        return false;
+    }
+
+    Logger::write(Logger::ZONE_INFO, "ImageLoader", "Started " + std::to_string(threads_.size()) + " artwork loader thread(s)");
+
+    return true;
+}
+
+
+void ImageLoader::deInitialize()
+{
+    if(mutex_)
+    {
+        SDL_LockMutex(mutex_);
+        running_ = false;
+        SDL_CondBroadcast(cond_);
+        SDL_UnlockMutex(mutex_);
+    }
+    running_ = false;
+
+    for(unsigned int i = 0; i < threads_.size(); ++i)
+    {
+        SDL_WaitThread(threads_[i], NULL);
+    }
+    threads_.clear();
+
+    // Requests that never started are still owned by their images; finish
+    // them empty so a later release() cleans them up.
+    for(std::list<Request *>::iterator it = queue_.begin(); it != queue_.end(); ++it)
+    {
+        (*it)->state = STATE_DONE;
+    }
+    queue_.clear();
+
+    if(cond_)
+    {
+        SDL_DestroyCond(cond_);
+        cond_ = NULL;
+    }
+    if(mutex_)
+    {
+        SDL_DestroyMutex(mutex_);
+        mutex_ = NULL;
+    }
+}
+
+
+ImageLoader::Request *ImageLoader::load(std::vector<std::string> &prefixes, std::vector<std::string> &extensions, int monitor)
+{
+    Request *request    = new Request();
+    request->prefixes   = prefixes;
+    request->extensions = extensions;
+    request->monitor    = monitor;
+    request->surface    = NULL;
+    request->state      = STATE_QUEUED;
+    request->released   = false;
+
+    if(!running_)
+    {
+        process(request);
+        request->state = STATE_DONE;
+        return request;
+    }
+
+    SDL_LockMutex(mutex_);
+    queue_.push_back(request);
+    SDL_CondSignal(cond_);
+    SDL_UnlockMutex(mutex_);
+
+    return request;
+}
+
+
+bool ImageLoader::poll(Request *request, SDL_Surface *&surface, std::string &file)
+{
+    bool done = false;
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    if(request->state == STATE_DONE)
+    {
+        surface          = request->surface;
+        file             = request->file;
+        request->surface = NULL;
+        done             = true;
+    }
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    return done;
+}
+
+
+void ImageLoader::release(Request *request)
+{
+    if(!request) return;
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    if(request->state == STATE_LOADING)
+    {
+        // the worker owns it until the decode finishes
+        request->released = true;
+        request = NULL;
+    }
+    else if(request->state == STATE_QUEUED)
+    {
+        queue_.remove(request);
+    }
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    if(request)
+    {
+        destroy(request);
+    }
+}
+
+
+int ImageLoader::worker(void *)
+{
+    SDL_LockMutex(mutex_);
+    while(running_)
+    {
+        if(queue_.empty())
+        {
+            SDL_CondWait(cond_, mutex_);
+            continue;
+        }
+
+        Request *request = queue_.front();
+        queue_.pop_front();
+        request->state = STATE_LOADING;
+        SDL_UnlockMutex(mutex_);
+
+        process(request);
+
+        SDL_LockMutex(mutex_);
+        request->state = STATE_DONE;
+        if(request->released)
+        {
+            destroy(request);
+        }
+    }
+    SDL_UnlockMutex(mutex_);
+
+    return 0;
+}
+
+
+void ImageLoader::process(Request *request)
+{
+    for(unsigned int i = 0; i < request->prefixes.size(); ++i)
+    {
+        if(MediaIndex::findMatchingFile(request->prefixes[i], request->extensions, request->file))
+        {
+            if(!TextureCache::contains(request->file, request->monitor))
+            {
+                request->surface = IMG_Load(request->file.c_str());
+            }
+            break;
+        }
+    }
+}
+
+
+void ImageLoader::destroy(Request *request)
+{
+    if(request->surface)
+    {
+        SDL_FreeSurface(request->surface);
+    }
+    delete request;
+}
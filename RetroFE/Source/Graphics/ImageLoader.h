@@ -0,0 +1,63 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <list>
+
+// Resolves and decodes artwork on background threads. Only the decoded
+// SDL_Surface is handed back; texture creation stays on the render thread.
+class ImageLoader
+{
+public:
+    struct Request;
+
+    static bool initialize(int numThreads);
+    static void deInitialize();
+
+    // Queue a load. Each prefix is probed with each extension, in order;
+    // the first file that exists is decoded, unless the texture cache
+    // already holds it for this monitor.
+    static Request *load(std::vector<std::string> &prefixes, std::vector<std::string> &extensions, int monitor);
+
+    // Returns true once the request is finished. Ownership of the surface
+    // passes to the caller. The surface is NULL if nothing was found or if
+    // the file was skipped because it is cached; file tells them apart.
+    static bool poll(Request *request, SDL_Surface *&surface, std::string &file);
+
+    // Drop a request; safe to call whether it is queued, loading or done.
+    static void release(Request *request);
+
+private:
+    enum RequestState
+    {
+        STATE_QUEUED,
+        STATE_LOADING,
+        STATE_DONE
+    };
+
+    static int  worker(void *context);
+    static void process(Request *request);
+    static void destroy(Request *request);
+
+    static std::vector<SDL_Thread *> threads_;
+    static std::list<Request *>      queue_;
+    static SDL_mutex                *mutex_;
+    static SDL_cond                 *cond_;
+    static bool                      running_;
+};
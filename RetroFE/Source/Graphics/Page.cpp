@@ -18,6 +18,7 @@
 #include "ComponentItemBinding.h"
 #include "Component/Component.h"
 #include "../Collection/CollectionInfo.h"
+#include "../Collection/CollectionCache.h"
 #include "Component/Text.h"
 #include "../Utility/Log.h"
 #include "Component/ScrollingList.h"
@@ -113,7 +114,7 @@ void Page::deInitialize()
 
         if(itc->collection)
         {
-            delete itc->collection;
+            CollectionCache::release(itc->collection);
         }
         collections_.erase(itc);
         itc = collections_.begin();
@@ -1352,7 +1353,7 @@ void Page::cleanup()
             if(info.collection)
             {
                 info.collection->Save();
-                delete info.collection;
+                CollectionCache::release(info.collection);
             }
             deleteCollections_.erase(del);
             del = next;
@@ -1367,20 +1368,32 @@ void Page::cleanup()
 
 void Page::draw()
 {
+    // Sort everything into its layer in a single pass, then draw the layers
+    // in order. Within a layer the page components come first, followed by
+    // the menus, which is the same order as walking every layer separately.
     for(unsigned int i = 0; i < NUM_LAYERS; ++i)
     {
-        for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
+        layerDrawLists_[i].clear();
+    }
+
+    for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
+    {
+        if(*it && (*it)->baseViewInfo.Layer < NUM_LAYERS) layerDrawLists_[(*it)->baseViewInfo.Layer].push_back(*it);
+    }
+
+    for(MenuVector_T::iterator it = menus_.begin(); it != menus_.end(); it++)
+    {
+        for(std::vector<ScrollingList *>::iterator it2 = it->begin(); it2 != it->end(); it2++)
         {
-            if(*it && (*it)->baseViewInfo.Layer == i) (*it)->draw();
+            (*it2)->addToLayers(layerDrawLists_, NUM_LAYERS);
         }
+    }
 
-        for(MenuVector_T::iterator it = menus_.begin(); it != menus_.end(); it++)
+    for(unsigned int i = 0; i < NUM_LAYERS; ++i)
+    {
+        for(std::vector<Component *>::iterator it = layerDrawLists_[i].begin(); it != layerDrawLists_[i].end(); ++it)
         {
-            for(std::vector<ScrollingList *>::iterator it2 = menus_[std::distance(menus_.begin(), it)].begin(); it2 != menus_[std::distance(menus_.begin(), it)].end(); it2++)
-            {
-                ScrollingList *menu = *it2;
-                menu->draw(i);
-            }
+            (*it)->draw();
         }
     }
 
@@ -1394,15 +1407,11 @@ void Page::removePlaylist()
     MenuInfo_S &info = collections_.back();
     CollectionInfo *collection = info.collection;
 
-    std::vector<Item *> *items = collection->playlists["favorites"];
-    std::vector<Item *>::iterator it = std::find(items->begin(), items->end(), selectedItem_);
-
-    if(it != items->end())
+    if(collection->removeFromPlaylist("favorites", selectedItem_))
     {
-        items->erase(it);
         selectedItem_->isFavorite = false;
-        collection->sortPlaylists();
         collection->saveRequest = true;
+        playlistChanged();
     }
     collection->Save();
 }
@@ -1415,13 +1424,11 @@ void Page::addPlaylist()
     MenuInfo_S &info = collections_.back();
     CollectionInfo *collection = info.collection;
 
-    std::vector<Item *> *items = collection->playlists["favorites"];
-    if(playlist_->first != "favorites" && std::find(items->begin(), items->end(), selectedItem_) == items->end())
+    if(playlist_->first != "favorites" && collection->addToPlaylist("favorites", selectedItem_))
     {
-        items->push_back(selectedItem_);
         selectedItem_->isFavorite = true;
-        collection->sortPlaylists();
         collection->saveRequest = true;
+        playlistChanged();
     }
     collection->Save();
 }
@@ -1438,6 +1445,20 @@ void Page::togglePlaylist()
 }
 
 
+// A playlist of the current collection was changed in place; the menus may
+// be showing it.
+void Page::playlistChanged()
+{
+    for(MenuVector_T::iterator it = menus_.begin(); it != menus_.end(); it++)
+    {
+        for(std::vector<ScrollingList *>::iterator it2 = it->begin(); it2 != it->end(); it2++)
+        {
+            (*it2)->itemsChanged();
+        }
+    }
+}
+
+
 std::string Page::getCollectionName()
 {
     if(collections_.size() == 0) return "";
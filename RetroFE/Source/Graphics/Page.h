@@ -117,6 +117,7 @@ public:
     void  addPlaylist();
     void  removePlaylist();
     void  togglePlaylist();
+    void  playlistChanged();
     void  updateLastPlayedPlaylist( Item *item );
     void  reallocateMenuSpritePoints();
     bool  isMenuScrolling();
@@ -165,6 +166,9 @@ private:
 
     static const unsigned int NUM_LAYERS = 20;
     std::vector<Component *> LayerComponents;
+    // components sorted into their layers for the current frame; the
+    // vectors keep their storage between frames
+    std::vector<Component *> layerDrawLists_[NUM_LAYERS];
     std::list<ScrollingList *> deleteMenuList_;
     std::list<CollectionInfo *> deleteCollectionList_;
 
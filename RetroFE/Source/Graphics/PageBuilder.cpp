@@ -988,6 +988,8 @@ ScrollingList * PageBuilder::buildMenu(xml_node<> *menuXml, Page &page)
     xml_attribute<> *scrollAccelerationXml = menuXml->first_attribute("scrollAcceleration");
     xml_attribute<> *minScrollTimeXml      = menuXml->first_attribute("minScrollTime");
     xml_attribute<> *scrollOrientationXml  = menuXml->first_attribute("orientation");
+    xml_attribute<> *prefetchAheadXml      = menuXml->first_attribute("prefetchAhead");
+    xml_attribute<> *prefetchBehindXml     = menuXml->first_attribute("prefetchBehind");
 
     if(menuTypeXml)
     {
@@ -1061,6 +1063,13 @@ ScrollingList * PageBuilder::buildMenu(xml_node<> *menuXml, Page &page)
         }
     }
 
+    if(prefetchAheadXml || prefetchBehindXml)
+    {
+        int prefetchAhead  = prefetchAheadXml  ? Utils::convertInt(prefetchAheadXml->value())  : 0;
+        int prefetchBehind = prefetchBehindXml ? Utils::convertInt(prefetchBehindXml->value()) : 0;
+        menu->setPrefetch(prefetchAhead > 0 ? prefetchAhead : 0, prefetchBehind > 0 ? prefetchBehind : 0);
+    }
+
     buildViewInfo(menuXml, menu->baseViewInfo);
 
     if(menuType == "custom")
@@ -1332,7 +1341,7 @@ void PageBuilder::buildViewInfo(xml_node<> *componentXml, ViewInfo &info, xml_no
     info.Alpha              = alpha              ? Utils::convertFloat(alpha->value())             : 1.f;
     info.Angle              = angle              ? Utils::convertFloat(angle->value())             : 0.f;
     info.Layer              = layer              ? Utils::convertInt(layer->value())               : 0;
-    info.Reflection         = reflection         ? reflection->value()                             : "";
+    info.Reflection         = reflection         ? ViewInfo::parseReflection(reflection->value())  : 0;
     info.ReflectionDistance = reflectionDistance ? Utils::convertInt(reflectionDistance->value())  : 0;
     info.ReflectionScale    = reflectionScale    ? Utils::convertFloat(reflectionScale->value())   : 0.25f;
     info.ReflectionAlpha    = reflectionAlpha    ? Utils::convertFloat(reflectionAlpha->value())   : 1.f;
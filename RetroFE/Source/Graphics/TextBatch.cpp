@@ -0,0 +1,69 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextBatch.h"
+#include "../SDL.h"
+
+TextBatch::TextBatch()
+    : used_(0)
+{
+}
+
+void TextBatch::begin()
+{
+    for(unsigned int i = 0; i < used_; ++i)
+    {
+        atlases_[i].src.clear();
+        atlases_[i].dest.clear();
+    }
+    used_ = 0;
+}
+
+void TextBatch::add(SDL_Texture *texture, const SDL_Rect &src, const SDL_Rect &dest)
+{
+    if(!texture) return;
+
+    unsigned int i = 0;
+    while(i < used_ && atlases_[i].texture != texture) ++i;
+
+    if(i == used_)
+    {
+        if(used_ == atlases_.size()) atlases_.push_back(Atlas());
+        atlases_[used_].texture = texture;
+        used_++;
+    }
+
+    atlases_[i].src.push_back(src);
+    atlases_[i].dest.push_back(dest);
+}
+
+void TextBatch::draw(float alpha, ViewInfo &viewInfo, int layoutWidth, int layoutHeight)
+{
+    for(unsigned int a = 0; a < used_; ++a)
+    {
+        Atlas &atlas = atlases_[a];
+
+        // fall back to a copy per glyph for what the geometry path can't do
+        // (angles, reflections, containers, mirroring)
+        if(!SDL::renderGeometry(atlas.texture, alpha, atlas.src, atlas.dest, viewInfo, layoutWidth, layoutHeight))
+        {
+            for(unsigned int i = 0; i < atlas.src.size(); ++i)
+            {
+                SDL::renderCopy(atlas.texture, alpha, &atlas.src[i], &atlas.dest[i], viewInfo, layoutWidth, layoutHeight);
+            }
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "ViewInfo.h"
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Collects the glyphs of a text component so the whole string is submitted
+// to the renderer at once instead of with one copy per character; one
+// submission per font atlas page the glyphs come from.
+class TextBatch
+{
+public:
+    TextBatch();
+    void begin();
+    void add(SDL_Texture *texture, const SDL_Rect &src, const SDL_Rect &dest);
+    void draw(float alpha, ViewInfo &viewInfo, int layoutWidth, int layoutHeight);
+
+private:
+    struct Atlas
+    {
+        SDL_Texture          *texture;
+        std::vector<SDL_Rect> src;
+        std::vector<SDL_Rect> dest;
+    };
+
+    std::vector<Atlas> atlases_; // entries past used_ keep their storage for later frames
+    unsigned int       used_;
+};
@@ -0,0 +1,239 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TextLayout.h"
+#include "Font.h"
+#include "../Utility/Utils.h"
+
+TextLayout::TextLayout()
+    : font_(NULL)
+    , generation_(0)
+    , fontSize_(0)
+    , maxWidth_(0)
+    , wrapped_(false)
+    , width_(0)
+    , spaceWidth_(0)
+{
+}
+
+const std::vector<TextLayout::Glyph> &TextLayout::getGlyphs() const
+{
+    return glyphs_;
+}
+
+const std::vector<TextLayout::Line> &TextLayout::getLines() const
+{
+    return lines_;
+}
+
+// font atlas pages used by the text; touch them when drawing from the cached
+// layout so the font keeps them
+const std::vector<unsigned int> &TextLayout::getPages() const
+{
+    return pages_;
+}
+
+// unscaled width of the text
+float TextLayout::getWidth() const
+{
+    return width_;
+}
+
+// scaled advance of a space
+unsigned int TextLayout::getSpaceWidth() const
+{
+    return spaceWidth_;
+}
+
+bool TextLayout::isCurrent(Font *font, float fontSize, float maxWidth) const
+{
+    // the generation changes when the font is reloaded or moves glyphs
+    return font_ == font && generation_ == font->getGeneration() && fontSize_ == fontSize && maxWidth_ == maxWidth;
+}
+
+void TextLayout::setInputs(Font *font, float fontSize, float maxWidth)
+{
+    font_       = font;
+    fontSize_   = fontSize;
+    maxWidth_   = maxWidth;
+    generation_ = font->getGeneration();
+}
+
+void TextLayout::addPage(unsigned int page)
+{
+    for(unsigned int i = 0; i < pages_.size(); ++i)
+    {
+        if(pages_[i] == page) return;
+    }
+    pages_.push_back(page);
+}
+
+// Lay out a single line, cut off after the last glyph that fits in maxWidth.
+// Returns true if the layout had to be recomputed.
+bool TextLayout::layoutLine(const std::string &text, Font *font, float fontSize, float maxWidth)
+{
+    if(!wrapped_ && text_.size() == 1 && text_[0] == text && isCurrent(font, fontSize, maxWidth)) return false;
+
+    text_.assign(1, text);
+    setInputs(font, fontSize, maxWidth);
+    wrapped_ = false;
+    glyphs_.clear();
+    lines_.clear();
+    pages_.clear();
+    width_ = 0;
+
+    float scale = fontSize / (float)font->getHeight();
+    unsigned int textIndexMax = 0;
+
+    for(unsigned int i = 0; i < text.size(); )
+    {
+        unsigned int start = i;
+        const Font::GlyphInfo *glyph = font->getGlyph(Utils::decodeUtf8(text, i));
+        if(glyph)
+        {
+            if(glyph->minX < 0)
+            {
+                width_ += glyph->minX;
+            }
+
+            if((width_ + glyph->advance)*scale > maxWidth)
+            {
+                break;
+            }
+
+            textIndexMax = start;
+            width_      += glyph->advance;
+        }
+    }
+
+    int x = 0;
+    for(unsigned int i = 0; i <= textIndexMax && i < text.size(); )
+    {
+        const Font::GlyphInfo *glyph = font->getGlyph(Utils::decodeUtf8(text, i));
+
+        if(glyph && glyph->rect.h > 0)
+        {
+            Glyph g;
+            addPage(glyph->page);
+            g.texture = glyph->texture;
+            g.src     = glyph->rect;
+            g.dest.h = static_cast<int>(glyph->rect.h * scale);
+            g.dest.w = static_cast<int>(glyph->rect.w * scale);
+            g.dest.y = 0;
+
+            if(glyph->minX < 0)
+            {
+                x += static_cast<int>((float)(glyph->minX) * scale);
+            }
+            if(font->getAscent() < glyph->maxY)
+            {
+                g.dest.y += static_cast<int>((font->getAscent() - glyph->maxY)*scale);
+            }
+            g.dest.x = x;
+            glyphs_.push_back(g);
+
+            x += static_cast<int>(glyph->advance * scale);
+        }
+    }
+
+    return true;
+}
+
+// Word-wrap paragraphs to maxWidth. Also totals the unscaled width of the
+// text as one line. Returns true if the layout had to be recomputed.
+bool TextLayout::wrap(const std::vector<std::string> &text, Font *font, float fontSize, float maxWidth)
+{
+    if(wrapped_ && text_ == text && isCurrent(font, fontSize, maxWidth)) return false;
+
+    text_ = text;
+    setInputs(font, fontSize, maxWidth);
+    wrapped_ = true;
+    glyphs_.clear();
+    lines_.clear();
+    pages_.clear();
+    width_      = 0;
+    spaceWidth_ = 0;
+
+    float scale = fontSize / (float)font->getHeight();
+
+    const Font::GlyphInfo *space = font->getGlyph(' ');
+    if(space)
+    {
+        spaceWidth_ = static_cast<int>(space->advance * scale);
+    }
+
+    for(unsigned int l = 0; l < text.size(); ++l)
+    {
+        for(unsigned int i = 0; i < text[l].size(); )
+        {
+            const Font::GlyphInfo *glyph = font->getGlyph(Utils::decodeUtf8(text[l], i));
+            if(glyph)
+            {
+                width_ += glyph->advance;
+            }
+        }
+
+        Line         line;
+        unsigned int width = 0;
+        line.width = 0;
+        line.last  = false;
+
+        std::string::size_type end = 0;
+        while(true)
+        {
+            std::string::size_type begin = text[l].find_first_not_of(" \t\n\v\f\r", end);
+            if(begin == std::string::npos) break;
+            end = text[l].find_first_of(" \t\n\v\f\r", begin);
+            std::string word = text[l].substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+
+            unsigned int wordWidth = 0;
+            for(unsigned int i = 0; i < word.size(); )
+            {
+                const Font::GlyphInfo *glyph = font->getGlyph(Utils::decodeUtf8(word, i));
+                if(glyph)
+                {
+                    addPage(glyph->page);
+                    wordWidth += static_cast<int>(glyph->advance * scale);
+                }
+            }
+
+            // start a new line if the word does not fit on this one
+            if(width > 0 && (width + spaceWidth_ + wordWidth > maxWidth))
+            {
+                lines_.push_back(line);
+                line.words.clear();
+                line.words.push_back(word);
+                line.width = wordWidth;
+                width      = wordWidth;
+            }
+            else
+            {
+                width      += (width == 0) ? wordWidth : spaceWidth_ + wordWidth;
+                line.width += wordWidth;
+                line.words.push_back(word);
+            }
+
+            if(end == std::string::npos) break;
+        }
+
+        if(text[l] == "" || !line.words.empty())
+        {
+            line.last = true;
+            lines_.push_back(line);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,70 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+class Font;
+
+// Glyph positions and line breaks of a text for a given font, font size and
+// maximum width. The layout is only recomputed when one of those changes, so
+// drawing the same text again just replays it.
+class TextLayout
+{
+public:
+    struct Glyph
+    {
+        SDL_Texture *texture; // font atlas page
+        SDL_Rect     src;     // part of the atlas page
+        SDL_Rect     dest;    // relative to the origin of the text
+    };
+
+    struct Line
+    {
+        std::vector<std::string> words;
+        unsigned int             width; // scaled width of the words, without spaces
+        bool                     last;  // last line of a paragraph
+    };
+
+    TextLayout();
+    bool layoutLine(const std::string &text, Font *font, float fontSize, float maxWidth);
+    bool wrap(const std::vector<std::string> &text, Font *font, float fontSize, float maxWidth);
+    const std::vector<Glyph> &getGlyphs() const;
+    const std::vector<Line> &getLines() const;
+    const std::vector<unsigned int> &getPages() const;
+    float getWidth() const;
+    unsigned int getSpaceWidth() const;
+
+private:
+    bool isCurrent(Font *font, float fontSize, float maxWidth) const;
+    void setInputs(Font *font, float fontSize, float maxWidth);
+    void addPage(unsigned int page);
+
+    std::vector<std::string> text_;
+    Font                    *font_;
+    unsigned int             generation_;
+    float                    fontSize_;
+    float                    maxWidth_;
+    bool                     wrapped_;
+
+    std::vector<Glyph>       glyphs_;
+    std::vector<Line>        lines_;
+    std::vector<unsigned int> pages_; // font atlas pages the glyphs are on
+    float                    width_;
+    unsigned int             spaceWidth_;
+};
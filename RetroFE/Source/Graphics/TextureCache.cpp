@@ -0,0 +1,292 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TextureCache.h"
+#include "../SDL.h"
+#include "../Utility/Log.h"
+#include <SDL2/SDL_image.h>
+
+struct TextureCache::Entry
+{
+    std::string                  key;
+    SDL_Texture                 *texture;
+    unsigned long long           bytes;
+    unsigned int                 refs;
+    std::list<Entry *>::iterator unused;
+};
+
+TextureCache::FileMap TextureCache::files_;
+TextureCache::TextureMap TextureCache::textures_;
+std::list<TextureCache::Entry *> TextureCache::unused_;
+SDL_mutex *TextureCache::mutex_ = NULL;
+unsigned long long TextureCache::budget_ = 0;
+unsigned long long TextureCache::bytes_ = 0;
+unsigned long long TextureCache::hits_ = 0;
+unsigned long long TextureCache::misses_ = 0;
+unsigned long long TextureCache::evictions_ = 0;
+
+
+void TextureCache::initialize(unsigned int budgetMB)
+{
+    if(!mutex_)
+    {
+        mutex_ = SDL_CreateMutex();
+    }
+
+    budget_    = (unsigned long long)budgetMB * 1024 * 1024;
+    hits_      = 0;
+    misses_    = 0;
+    evictions_ = 0;
+
+    Logger::write(Logger::ZONE_INFO, "TextureCache", "Keeping up to " + std::to_string(budgetMB) + " MB of unused textures");
+}
+
+
+void TextureCache::deInitialize()
+{
+    clear();
+    logStatistics();
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    if(!files_.empty())
+    {
+        // still held by components; they release into an empty cache
+        Logger::write(Logger::ZONE_WARNING, "TextureCache", std::to_string(files_.size()) + " texture(s) still in use at shutdown");
+        for(FileMap::iterator it = files_.begin(); it != files_.end(); ++it)
+        {
+            delete it->second;
+        }
+        files_.clear();
+        textures_.clear();
+    }
+    bytes_ = 0;
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    if(mutex_)
+    {
+        SDL_DestroyMutex(mutex_);
+        mutex_ = NULL;
+    }
+}
+
+
+void TextureCache::clear()
+{
+    if(mutex_) SDL_LockMutex(mutex_);
+    while(!unused_.empty())
+    {
+        Entry *entry = unused_.back();
+        unused_.pop_back();
+        destroy(entry);
+    }
+    if(mutex_) SDL_UnlockMutex(mutex_);
+}
+
+
+SDL_Texture *TextureCache::acquire(std::string file, int monitor)
+{
+    SDL_Texture *texture = NULL;
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    FileMap::iterator it = files_.find(key(file, monitor));
+    if(it != files_.end())
+    {
+        Entry *entry = it->second;
+        if(entry->refs == 0)
+        {
+            unused_.erase(entry->unused);
+        }
+        entry->refs++;
+        texture = entry->texture;
+        hits_++;
+    }
+    else
+    {
+        misses_++;
+    }
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    return texture;
+}
+
+
+SDL_Texture *TextureCache::load(std::string file, int monitor)
+{
+    SDL_Texture *texture = acquire(file, monitor);
+    if(texture)
+    {
+        return texture;
+    }
+
+    SDL_LockMutex(SDL::getMutex());
+    texture = IMG_LoadTexture(SDL::getRenderer(monitor), file.c_str());
+    if(texture)
+    {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+    SDL_UnlockMutex(SDL::getMutex());
+
+    if(!texture)
+    {
+        return NULL;
+    }
+
+    return add(file, monitor, texture);
+}
+
+
+SDL_Texture *TextureCache::insert(std::string file, int monitor, SDL_Surface *surface)
+{
+    SDL_Texture *texture = acquire(file, monitor);
+    if(texture)
+    {
+        return texture;
+    }
+
+    SDL_LockMutex(SDL::getMutex());
+    texture = SDL_CreateTextureFromSurface(SDL::getRenderer(monitor), surface);
+    if(texture)
+    {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+    SDL_UnlockMutex(SDL::getMutex());
+
+    if(!texture)
+    {
+        return NULL;
+    }
+
+    return add(file, monitor, texture);
+}
+
+
+bool TextureCache::contains(std::string file, int monitor)
+{
+    if(mutex_) SDL_LockMutex(mutex_);
+    bool found = (files_.find(key(file, monitor)) != files_.end());
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    return found;
+}
+
+
+void TextureCache::release(SDL_Texture *texture)
+{
+    if(!texture) return;
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    TextureMap::iterator it = textures_.find(texture);
+    if(it == textures_.end())
+    {
+        // not ours (e.g. forgotten at shutdown), so nobody else can be using it
+        SDL_LockMutex(SDL::getMutex());
+        SDL_DestroyTexture(texture);
+        SDL_UnlockMutex(SDL::getMutex());
+    }
+    else
+    {
+        Entry *entry = it->second;
+        if(--entry->refs == 0)
+        {
+            unused_.push_front(entry);
+            entry->unused = unused_.begin();
+            trim();
+        }
+    }
+    if(mutex_) SDL_UnlockMutex(mutex_);
+}
+
+
+void TextureCache::getStatistics(Statistics &stats)
+{
+    if(mutex_) SDL_LockMutex(mutex_);
+    stats.hits      = hits_;
+    stats.misses    = misses_;
+    stats.evictions = evictions_;
+    stats.bytes     = bytes_;
+    stats.budget    = budget_;
+    stats.entries   = files_.size();
+    if(mutex_) SDL_UnlockMutex(mutex_);
+}
+
+
+void TextureCache::logStatistics()
+{
+    Statistics stats;
+    getStatistics(stats);
+
+    Logger::write(Logger::ZONE_INFO, "TextureCache",
+        std::to_string(stats.hits) + " hits, " +
+        std::to_string(stats.misses) + " misses, " +
+        std::to_string(stats.evictions) + " evictions, " +
+        std::to_string(stats.entries) + " texture(s) using " +
+        std::to_string(stats.bytes / 1024) + " of " +
+        std::to_string(stats.budget / 1024) + " KB");
+}
+
+
+std::string TextureCache::key(std::string &file, int monitor)
+{
+    return std::to_string(monitor) + ":" + file;
+}
+
+
+SDL_Texture *TextureCache::add(std::string &file, int monitor, SDL_Texture *texture)
+{
+    int width  = 0;
+    int height = 0;
+    SDL_QueryTexture(texture, NULL, NULL, &width, &height);
+
+    Entry *entry   = new Entry();
+    entry->key     = key(file, monitor);
+    entry->texture = texture;
+    entry->bytes   = (unsigned long long)width * height * 4;
+    entry->refs    = 1;
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    files_[entry->key] = entry;
+    textures_[texture] = entry;
+    bytes_ += entry->bytes;
+    trim();
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    return texture;
+}
+
+
+void TextureCache::trim()
+{
+    while(bytes_ > budget_ && !unused_.empty())
+    {
+        Entry *entry = unused_.back();
+        unused_.pop_back();
+        destroy(entry);
+        evictions_++;
+    }
+}
+
+
+void TextureCache::destroy(Entry *entry)
+{
+    files_.erase(entry->key);
+    textures_.erase(entry->texture);
+    bytes_ -= entry->bytes;
+
+    SDL_LockMutex(SDL::getMutex());
+    SDL_DestroyTexture(entry->texture);
+    SDL_UnlockMutex(SDL::getMutex());
+
+    delete entry;
+}
@@ -0,0 +1,81 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <map>
+#include <list>
+
+// Shares decoded textures between images that show the same file. Textures
+// that are no longer referenced stay resident, least recently used first
+// out, until the byte budget is exceeded.
+class TextureCache
+{
+public:
+    struct Statistics
+    {
+        unsigned long long hits;
+        unsigned long long misses;
+        unsigned long long evictions;
+        unsigned long long bytes;
+        unsigned long long budget;
+        unsigned int       entries;
+    };
+
+    static void initialize(unsigned int budgetMB);
+    static void deInitialize();
+
+    // Destroy every texture nobody is using, e.g. before the renderers go away.
+    static void clear();
+
+    // Returns a referenced texture, or NULL if the file is not cached.
+    static SDL_Texture *acquire(std::string file, int monitor);
+
+    // Like acquire(), but decodes and caches the file on a miss.
+    static SDL_Texture *load(std::string file, int monitor);
+
+    // Uploads an already decoded surface. The caller keeps the surface.
+    static SDL_Texture *insert(std::string file, int monitor, SDL_Surface *surface);
+
+    // Safe to call from any thread; does not touch the statistics.
+    static bool contains(std::string file, int monitor);
+
+    static void release(SDL_Texture *texture);
+
+    static void getStatistics(Statistics &stats);
+    static void logStatistics();
+
+private:
+    struct Entry;
+    typedef std::map<std::string, Entry *> FileMap;
+    typedef std::map<SDL_Texture *, Entry *> TextureMap;
+
+    static std::string key(std::string &file, int monitor);
+    static SDL_Texture *add(std::string &file, int monitor, SDL_Texture *texture);
+    static void trim();
+    static void destroy(Entry *entry);
+
+    static FileMap              files_;
+    static TextureMap           textures_;
+    static std::list<Entry *>   unused_;
+    static SDL_mutex           *mutex_;
+    static unsigned long long   budget_;
+    static unsigned long long   bytes_;
+    static unsigned long long   hits_;
+    static unsigned long long   misses_;
+    static unsigned long long   evictions_;
+};
@@ -43,7 +43,7 @@ ViewInfo::ViewInfo()
     , BackgroundGreen(0)
     , BackgroundBlue(0)
     , BackgroundAlpha(0)
-    , Reflection("")
+    , Reflection(0)
     , ReflectionDistance(0)
     , ReflectionScale(.25)
     , ReflectionAlpha(1)
@@ -61,6 +61,18 @@ ViewInfo::~ViewInfo()
 {
 }
 
+unsigned int ViewInfo::parseReflection(const std::string &reflection)
+{
+    unsigned int flags = 0;
+
+    if(reflection.find("top") != std::string::npos)    flags |= ReflectionTop;
+    if(reflection.find("bottom") != std::string::npos) flags |= ReflectionBottom;
+    if(reflection.find("left") != std::string::npos)   flags |= ReflectionLeft;
+    if(reflection.find("right") != std::string::npos)  flags |= ReflectionRight;
+
+    return flags;
+}
+
 float ViewInfo::XRelativeToOrigin() const
 {
     return X + XOffset - XOrigin*ScaledWidth();
@@ -40,6 +40,13 @@ public:
     static const int AlignRight = -4;
     static const int AlignBottom = -5;
 
+    // Reflection flags, parsed from the layout's reflection attribute
+    static const unsigned int ReflectionTop    = 1;
+    static const unsigned int ReflectionBottom = 2;
+    static const unsigned int ReflectionLeft   = 4;
+    static const unsigned int ReflectionRight  = 8;
+    static unsigned int parseReflection(const std::string &reflection);
+
     float        X;
     float        Y;
     float        XOrigin;
@@ -63,7 +70,7 @@ public:
     float        BackgroundGreen;
     float        BackgroundBlue;
     float        BackgroundAlpha;
-    std::string  Reflection;
+    unsigned int Reflection;
     unsigned int ReflectionDistance;
     float        ReflectionScale;
     float        ReflectionAlpha;
@@ -33,7 +33,7 @@ Menu::Menu( Configuration &c, UserInput &ui )
 
 void Menu::handleEntry( Item *item )
 {
-    std::cout << "Handling " + item->ctrlType + "." << std::endl;
+    std::cout << "Handling " + item->ctrlType.str( ) + "." << std::endl;
     std::string key  = getKey();
     std::string ctrl = item->ctrlType;
     ctrl.erase( 0, 1 );
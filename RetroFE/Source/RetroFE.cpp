@@ -17,6 +17,7 @@
 
 #include "RetroFE.h"
 #include "Collection/CollectionInfoBuilder.h"
+#include "Collection/CollectionCache.h"
 #include "Collection/CollectionInfo.h"
 #include "Database/Configuration.h"
 #include "Collection/Item.h"
@@ -29,6 +30,10 @@
 #include "Control/UserInput.h"
 #include "Graphics/PageBuilder.h"
 #include "Graphics/Page.h"
+#include "Graphics/ImageLoader.h"
+#include "Graphics/TextureCache.h"
+#include "Utility/MediaIndex.h"
+#include "Utility/InternedString.h"
 #include "Graphics/Component/ScrollingList.h"
 #include "Graphics/Component/Video.h"
 #include <gst/gst.h>
@@ -71,7 +76,11 @@ RetroFE::RetroFE( Configuration &c )
     , keyLastTime_(0)
     , keyDelayTime_(.3f)
     , reboot_(false)
+    , collectionThread_(NULL)
+    , collectionLoadMenu_(false)
+    , collectionLoadInfo_(NULL)
 {
+    SDL_AtomicSet( &collectionLoadDone_, 0 );
     menuMode_                            = false;
     attractMode_                         = false;
     attractModePlaylistCollectionNumber_ = 0;
@@ -90,6 +99,7 @@ void RetroFE::render( )
 {
 
     SDL_LockMutex( SDL::getMutex( ) );
+    SDL::updateTransforms( );
     for ( int i = 0; i < SDL::getNumDisplays( ); ++i )
     {
         SDL_SetRenderDrawColor( SDL::getRenderer( i ), 0x0, 0x0, 0x00, 0xFF );
@@ -143,6 +153,9 @@ int RetroFE::initialize( void *context )
         return -1;
     }
 
+    // Restore the media directory listings from the last run
+    MediaIndex::load( *(instance->db_) );
+
     instance->initialized = true;
     return 0;
 
@@ -227,6 +240,7 @@ void RetroFE::freeGraphicsMemory( )
     if ( unloadSDL )
     {
         currentPage_->deInitializeFonts( );
+        TextureCache::clear( );
         SDL::deInitialize( );
         input_.clearJoysticks( );
     }
@@ -262,6 +276,18 @@ bool RetroFE::deInitialize( )
 
     bool retVal = true;
 
+    // Wait for a collection that is still being built
+    if ( collectionThread_ )
+    {
+        SDL_WaitThread( collectionThread_, NULL );
+        collectionThread_ = NULL;
+    }
+    if ( collectionLoadInfo_ )
+    {
+        delete collectionLoadInfo_;
+        collectionLoadInfo_ = NULL;
+    }
+
     // Free textures
     freeGraphicsMemory( );
 
@@ -273,6 +299,22 @@ bool RetroFE::deInitialize( )
         currentPage_ = NULL;
     }
 
+    // Stop the artwork loader threads
+    ImageLoader::deInitialize( );
+
+    // Drop the cached collections
+    CollectionCache::deInitialize( );
+
+    // Drop the cached textures
+    TextureCache::deInitialize( );
+
+    // Keep the media directory listings for the next start
+    if ( db_ )
+    {
+        MediaIndex::save( *db_ );
+    }
+    MediaIndex::deInitialize( );
+
     // Delete databases
     if ( metadb_ )
     {
@@ -307,10 +349,35 @@ bool RetroFE::deInitialize( )
 bool RetroFE::run( )
 {
 
+    // Read the settings the main loop acts on; the configuration does not
+    // change until the next reboot
+    settings_.load( config_ );
+
     // Initialize SDL
     if(! SDL::initialize( config_ ) ) return false;
     fontcache_.initialize( );
 
+    // Set up the texture cache
+    int textureCacheMB = 128;
+    config_.getProperty( "textureCacheMB", textureCacheMB );
+    TextureCache::initialize( textureCacheMB > 0 ? textureCacheMB : 0 );
+
+    // Set up the collection cache
+    int collectionCacheSize = 8;
+    config_.getProperty( "collectionCacheSize", collectionCacheSize );
+    CollectionCache::initialize( collectionCacheSize > 0 ? collectionCacheSize : 0 );
+
+    // Set up the media directory index
+    MediaIndex::initialize( );
+
+    // Set up the table of shared item metadata strings
+    InternedString::initialize( );
+
+    // Start the artwork loader threads
+    int artworkLoaderThreads = 2;
+    config_.getProperty( "artworkLoaderThreads", artworkLoaderThreads );
+    ImageLoader::initialize( artworkLoaderThreads );
+
     // Define control configuration
     std::string controlsConfPath = Utils::combinePath( Configuration::absolutePath, "controls.conf" );
     if ( !config_.import( "controls", controlsConfPath ) )
@@ -338,40 +405,20 @@ bool RetroFE::run( )
         return false;
     }
 
-    int attractModeTime           = 0;
-    int attractModeNextTime       = 0;
-    int attractModePlaylistTime   = 0;
-    int attractModeCollectionTime = 0;
-    int attractModeMinTime        = 1000;
-    int attractModeMaxTime        = 5000;
-    std::string firstCollection   = "Main";
     bool running                  = true;
     RETROFE_STATE state           = RETROFE_NEW;
 
-    config_.getProperty( "attractModeTime", attractModeTime );
-    config_.getProperty( "attractModeNextTime", attractModeNextTime );
-    config_.getProperty( "attractModePlaylistTime", attractModePlaylistTime );
-    config_.getProperty( "attractModeCollectionTime", attractModeCollectionTime );
-    config_.getProperty( "attractModeMinTime", attractModeMinTime );
-    config_.getProperty( "attractModeMaxTime", attractModeMaxTime );
-    config_.getProperty( "firstCollection", firstCollection );
-
-    attract_.idleTime           = static_cast<float>(attractModeTime);
-    attract_.idleNextTime       = static_cast<float>(attractModeNextTime);
-    attract_.idlePlaylistTime   = static_cast<float>(attractModePlaylistTime);
-    attract_.idleCollectionTime = static_cast<float>(attractModeCollectionTime);
-    attract_.minTime            = attractModeMinTime;
-    attract_.maxTime            = attractModeMaxTime;
-
-    int fps     = 60;
-    int fpsIdle = 60;
-    config_.getProperty( "fps", fps );
-    config_.getProperty( "fpsIdle", fpsIdle );
-    double fpsTime     = 1000.0 / static_cast<double>(fps);
-    double fpsIdleTime = 1000.0 / static_cast<double>(fpsIdle);
+    attract_.idleTime           = static_cast<float>(settings_.attractModeTime);
+    attract_.idleNextTime       = static_cast<float>(settings_.attractModeNextTime);
+    attract_.idlePlaylistTime   = static_cast<float>(settings_.attractModePlaylistTime);
+    attract_.idleCollectionTime = static_cast<float>(settings_.attractModeCollectionTime);
+    attract_.minTime            = settings_.attractModeMinTime;
+    attract_.maxTime            = settings_.attractModeMaxTime;
+
+    double fpsTime     = 1000.0 / static_cast<double>(settings_.fps);
+    double fpsIdleTime = 1000.0 / static_cast<double>(settings_.fpsIdle);
 
     int initializeStatus = 0;
-    bool inputClear      = false;
 
     // load the initial splash screen, unload it once it is complete
     currentPage_        = loadSplashPage( );
@@ -450,6 +497,10 @@ bool RetroFE::run( )
                 }
 
                 currentPage_->stop( );
+
+                // build the first collection while the splash screen exits
+                startCollectionLoad( settings_.firstCollection, false );
+
                 state = RETROFE_SPLASH_EXIT;
 
             }
@@ -466,10 +517,8 @@ bool RetroFE::run( )
         case RETROFE_ENTER:
             if ( currentPage_->isIdle( ) )
             {
-                bool startCollectionEnter = false;
-                config_.getProperty( "startCollectionEnter", startCollectionEnter );
                 nextPageItem_ = currentPage_->getSelectedItem( );
-                if ( !splashMode && startCollectionEnter && !nextPageItem_->leaf )
+                if ( !splashMode && settings_.startCollectionEnter && !nextPageItem_->leaf )
                 {
                     state = RETROFE_NEXT_PAGE_REQUEST;
                 }
@@ -484,6 +533,19 @@ bool RetroFE::run( )
         case RETROFE_SPLASH_EXIT:
             if ( currentPage_->isIdle( ) )
             {
+                state = RETROFE_SPLASH_COLLECTION_LOAD;
+            }
+            break;
+
+        // Wait for the first collection to be built; switch to the standard menu
+        case RETROFE_SPLASH_COLLECTION_LOAD:
+            {
+                CollectionInfo *info = NULL;
+                if ( !collectionLoaded( info ) )
+                {
+                    break;
+                }
+
                 // delete the splash screen and use the standard menu
                 currentPage_->deInitialize( );
                 delete currentPage_;
@@ -492,15 +554,11 @@ bool RetroFE::run( )
                 splashMode = false;
                 if ( currentPage_ )
                 {
-                    std::string firstCollection = "Main";
-
-                    config_.getProperty( "firstCollection", firstCollection );
-                    config_.setProperty( "currentCollection", firstCollection );
-                    CollectionInfo *info = getCollection(firstCollection);
+                    config_.setProperty( "currentCollection", settings_.firstCollection );
 
                     currentPage_->pushCollection(info);
 
-                    config_.getProperty( "firstPlaylist", firstPlaylist_ );
+                    firstPlaylist_ = settings_.firstPlaylist;
                     currentPage_->selectPlaylist( firstPlaylist_ );
                     if (currentPage_->getPlaylistName() != firstPlaylist_ )
                         currentPage_->selectPlaylist( "all" );
@@ -512,6 +570,7 @@ bool RetroFE::run( )
                 }
                 else
                 {
+                    delete info;
                     state = RETROFE_QUIT_REQUEST;
                 }
             }
@@ -519,9 +578,7 @@ bool RetroFE::run( )
 
         // Switch playlist; start onHighlightExit animation
         case RETROFE_PLAYLIST_REQUEST:
-            inputClear = false;
-            config_.getProperty( "playlistInputClear", inputClear );
-            if (  inputClear  )
+            if ( settings_.playlistInputClear )
             {
                 // Empty event queue
                 SDL_Event e;
@@ -563,9 +620,7 @@ bool RetroFE::run( )
 
         // Jump in menu; start onMenuJumpExit animation
         case RETROFE_MENUJUMP_REQUEST:
-            inputClear = false;
-            config_.getProperty( "jumpInputClear", inputClear );
-            if (  inputClear  )
+            if ( settings_.jumpInputClear )
             {
                 // Empty event queue
                 SDL_Event e;
@@ -651,7 +706,7 @@ bool RetroFE::run( )
             state = RETROFE_NEXT_PAGE_MENU_EXIT;
             break;
 
-        // Wait for onMenuExit animation to finish; load new page if applicable; load art
+        // Wait for onMenuExit animation to finish; start building the next collection
         case RETROFE_NEXT_PAGE_MENU_EXIT:
             if ( currentPage_->isIdle( ) )
             {
@@ -659,13 +714,25 @@ bool RetroFE::run( )
                     l.LEDBlinky( 8, currentPage_->getSelectedItem( )->name, currentPage_->getSelectedItem( ) );
                 lastMenuOffsets_[currentPage_->getCollectionName( )]   = currentPage_->getScrollOffsetIndex( );
                 lastMenuPlaylists_[currentPage_->getCollectionName( )] = currentPage_->getPlaylistName( );
+                startCollectionLoad( nextPageItem_->name, menuMode_ );
+                state = RETROFE_NEXT_PAGE_COLLECTION_LOAD;
+            }
+            break;
+
+        // Wait for the collection to be built; load new page if applicable; load art
+        case RETROFE_NEXT_PAGE_COLLECTION_LOAD:
+            {
+                CollectionInfo *info = NULL;
+                if ( !collectionLoaded( info ) )
+                {
+                    break;
+                }
+
                 std::string nextPageName = nextPageItem_->name;
                 if ( !menuMode_ )
                 {
                     // Load new layout if available
-                    std::string layoutName;
-                    config_.getProperty( "layout", layoutName );
-                    PageBuilder pb( layoutName, "layout", config_, &fontcache_ );
+                    PageBuilder pb( settings_.layout, "layout", config_, &fontcache_ );
                     Page *page = pb.buildPage( nextPageItem_->name );
                     if ( page )
                     {
@@ -677,32 +744,20 @@ bool RetroFE::run( )
 
                 config_.setProperty( "currentCollection", nextPageName );
 
-                CollectionInfo *info;
-                if ( menuMode_ )
-                    info = getMenuCollection( nextPageName );
-                else
-                    info = getCollection( nextPageName );
-
                 currentPage_->pushCollection(info);
 
-                bool rememberMenu = false;
-                config_.getProperty( "rememberMenu", rememberMenu );
-
-                std::string autoPlaylist = "all";
-                config_.getProperty( "autoPlaylist", autoPlaylist );
-
-                if (rememberMenu && lastMenuPlaylists_.find( nextPageName ) != lastMenuPlaylists_.end( ))
+                if (settings_.rememberMenu && lastMenuPlaylists_.find( nextPageName ) != lastMenuPlaylists_.end( ))
                 {
                     currentPage_->selectPlaylist( lastMenuPlaylists_[nextPageName] ); // Switch to last playlist
                 }
                 else
                 {
-                    currentPage_->selectPlaylist( autoPlaylist );
-                    if (currentPage_->getPlaylistName() != autoPlaylist )
+                    currentPage_->selectPlaylist( settings_.autoPlaylist );
+                    if (currentPage_->getPlaylistName() != settings_.autoPlaylist )
                         currentPage_->selectPlaylist( "all" );
                 }
 
-                if ( rememberMenu && lastMenuOffsets_.find( nextPageName ) != lastMenuOffsets_.end( ) )
+                if ( settings_.rememberMenu && lastMenuOffsets_.find( nextPageName ) != lastMenuOffsets_.end( ) )
                 {
                     currentPage_->setScrollOffsetIndex( lastMenuOffsets_[nextPageName] );
                 }
@@ -715,9 +770,7 @@ bool RetroFE::run( )
                 // Check if we've entered an empty collection and need to go back automatically
                 if (currentPage_->getCollectionSize() == 0)
                 {
-                    bool backOnEmpty = false;
-                    config_.getProperty( "backOnEmpty", backOnEmpty );
-                    if (backOnEmpty)
+                    if (settings_.backOnEmpty)
                         state = RETROFE_BACK_MENU_EXIT;
                 }
 
@@ -744,9 +797,7 @@ bool RetroFE::run( )
         case RETROFE_NEXT_PAGE_MENU_ENTER:
             if ( currentPage_->isIdle( ) )
             {
-                inputClear = false;
-                config_.getProperty( "collectionInputClear", inputClear );
-                if (  inputClear  )
+                if ( settings_.collectionInputClear )
                 {
                     // Empty event queue
                     SDL_Event e;
@@ -779,16 +830,12 @@ bool RetroFE::run( )
                 if ( attractMode_ ) // Check playlist change in attract mode
                 {
                     attractModePlaylistCollectionNumber_   += 1;
-                    int attractModePlaylistCollectionNumber = 0;
-                    config_.getProperty( "attractModePlaylistCollectionNumber", attractModePlaylistCollectionNumber );
                     // Check if playlist should be changed
-                    if ( attractModePlaylistCollectionNumber_ > 0 && attractModePlaylistCollectionNumber_ >= attractModePlaylistCollectionNumber )
+                    if ( attractModePlaylistCollectionNumber_ > 0 && attractModePlaylistCollectionNumber_ >= settings_.attractModePlaylistCollectionNumber )
                     {
                         attractModePlaylistCollectionNumber_ = 0;
                         currentPage_->nextPlaylist( );
-                        std::string attractModeSkipPlaylist = "";
-                        config_.getProperty( "attractModeSkipPlaylist", attractModeSkipPlaylist );
-                        if (currentPage_->getPlaylistName( ) == attractModeSkipPlaylist)
+                        if (currentPage_->getPlaylistName( ) == settings_.attractModeSkipPlaylist)
                             currentPage_->nextPlaylist( );
                         state = RETROFE_PLAYLIST_REQUEST;
                     }
@@ -816,24 +863,18 @@ bool RetroFE::run( )
                 }
                 config_.setProperty( "currentCollection", currentPage_->getCollectionName( ) );
 
-                bool rememberMenu = false;
-                config_.getProperty( "rememberMenu", rememberMenu );
-
-                std::string autoPlaylist = "all";
-                config_.getProperty( "autoPlaylist", autoPlaylist );
-
-                if (rememberMenu && lastMenuPlaylists_.find( currentPage_->getCollectionName( ) ) != lastMenuPlaylists_.end( ))
+                if (settings_.rememberMenu && lastMenuPlaylists_.find( currentPage_->getCollectionName( ) ) != lastMenuPlaylists_.end( ))
                 {
                     currentPage_->selectPlaylist( lastMenuPlaylists_[currentPage_->getCollectionName( )] ); // Switch to last playlist
                 }
                 else
                 {
-                    currentPage_->selectPlaylist( autoPlaylist );
-                    if (currentPage_->getPlaylistName() != autoPlaylist )
+                    currentPage_->selectPlaylist( settings_.autoPlaylist );
+                    if (currentPage_->getPlaylistName() != settings_.autoPlaylist )
                         currentPage_->selectPlaylist( "all" );
                 }
 
-                if (rememberMenu && lastMenuPlaylists_.find( currentPage_->getCollectionName( ) ) != lastMenuPlaylists_.end( ))
+                if (settings_.rememberMenu && lastMenuPlaylists_.find( currentPage_->getCollectionName( ) ) != lastMenuPlaylists_.end( ))
                 {
                     currentPage_->setScrollOffsetIndex( lastMenuOffsets_[currentPage_->getCollectionName( )] );
                 }
@@ -844,16 +885,12 @@ bool RetroFE::run( )
                 if ( attractMode_ ) // Check playlist change in attract mode
                 {
                     attractModePlaylistCollectionNumber_   += 1;
-                    int attractModePlaylistCollectionNumber = 0;
-                    config_.getProperty( "attractModePlaylistCollectionNumber", attractModePlaylistCollectionNumber );
                     // Check if playlist should be changed
-                    if ( attractModePlaylistCollectionNumber_ > 0 && attractModePlaylistCollectionNumber_ >= attractModePlaylistCollectionNumber )
+                    if ( attractModePlaylistCollectionNumber_ > 0 && attractModePlaylistCollectionNumber_ >= settings_.attractModePlaylistCollectionNumber )
                     {
                         attractModePlaylistCollectionNumber_ = 0;
                         currentPage_->nextPlaylist( );
-                        std::string attractModeSkipPlaylist = "";
-                        config_.getProperty( "attractModeSkipPlaylist", attractModeSkipPlaylist );
-                        if (currentPage_->getPlaylistName( ) == attractModeSkipPlaylist)
+                        if (currentPage_->getPlaylistName( ) == settings_.attractModeSkipPlaylist)
                             currentPage_->nextPlaylist( );
                         state = RETROFE_PLAYLIST_REQUEST;
                     }
@@ -874,9 +911,7 @@ bool RetroFE::run( )
         case RETROFE_COLLECTION_DOWN_ENTER:
             if ( currentPage_->isIdle( ) )
             {
-                int attractModePlaylistCollectionNumber = 0;
-                config_.getProperty( "attractModePlaylistCollectionNumber", attractModePlaylistCollectionNumber );
-                if (!( attractMode_ && attractModePlaylistCollectionNumber > 0 && attractModePlaylistCollectionNumber_ == 0 ))
+                if (!( attractMode_ && settings_.attractModePlaylistCollectionNumber > 0 && attractModePlaylistCollectionNumber_ == 0 ))
                 {
                     currentPage_->setScrolling(Page::ScrollDirectionForward);
                     currentPage_->scroll(true);
@@ -890,10 +925,8 @@ bool RetroFE::run( )
         case RETROFE_COLLECTION_DOWN_SCROLL:
             if ( currentPage_->isMenuIdle( ) )
             {
-                std::string attractModeSkipCollection = "";
-                config_.getProperty( "attractModeSkipCollection", attractModeSkipCollection );
                 // Check if we need to skip this collection in attract mode or if we can select it
-                if ( attractMode_ && currentPage_->getSelectedItem( )->name == attractModeSkipCollection )
+                if ( attractMode_ && currentPage_->getSelectedItem( )->name == settings_.attractModeSkipCollection )
                 {
                     currentPage_->setScrolling(Page::ScrollDirectionForward);
                     currentPage_->scroll(true);
@@ -914,9 +947,7 @@ bool RetroFE::run( )
                     {
                         currentPage_->setScrolling(Page::ScrollDirectionIdle); // Stop scrolling
                         nextPageItem_ = currentPage_->getSelectedItem( );
-                        bool enterOnCollection = true;
-                        config_.getProperty( "enterOnCollection", enterOnCollection );
-                        if ( currentPage_->getSelectedItem( )->leaf || (!attractMode_ && !enterOnCollection) ) // Current selection is a game or enterOnCollection is not set
+                        if ( currentPage_->getSelectedItem( )->leaf || (!attractMode_ && !settings_.enterOnCollection) ) // Current selection is a game or enterOnCollection is not set
                         {
                             state = RETROFE_HIGHLIGHT_REQUEST;
                         }
@@ -1013,24 +1044,18 @@ bool RetroFE::run( )
                 }
                 config_.setProperty( "currentCollection", currentPage_->getCollectionName( ) );
 
-                bool rememberMenu = false;
-                config_.getProperty( "rememberMenu", rememberMenu );
-
-                std::string autoPlaylist = "all";
-                config_.getProperty( "autoPlaylist", autoPlaylist );
-
-                if (rememberMenu && lastMenuPlaylists_.find( currentPage_->getCollectionName( ) ) != lastMenuPlaylists_.end( ))
+                if (settings_.rememberMenu && lastMenuPlaylists_.find( currentPage_->getCollectionName( ) ) != lastMenuPlaylists_.end( ))
                 {
                   currentPage_->selectPlaylist( lastMenuPlaylists_[currentPage_->getCollectionName( )] ); // Switch to last playlist
                 }
                 else
                 {
-                    currentPage_->selectPlaylist( autoPlaylist );
-                    if (currentPage_->getPlaylistName() != autoPlaylist )
+                    currentPage_->selectPlaylist( settings_.autoPlaylist );
+                    if (currentPage_->getPlaylistName() != settings_.autoPlaylist )
                         currentPage_->selectPlaylist( "all" );
                 }
 
-                if ( rememberMenu && lastMenuOffsets_.find( currentPage_->getCollectionName( ) ) != lastMenuOffsets_.end( ) )
+                if ( settings_.rememberMenu && lastMenuOffsets_.find( currentPage_->getCollectionName( ) ) != lastMenuOffsets_.end( ) )
                 {
                     currentPage_->setScrollOffsetIndex( lastMenuOffsets_[currentPage_->getCollectionName( )] );
                 }
@@ -1077,9 +1102,7 @@ bool RetroFE::run( )
                 {
                     currentPage_->setScrolling(Page::ScrollDirectionIdle); // Stop scrolling
                     nextPageItem_ = currentPage_->getSelectedItem( );
-                    bool enterOnCollection = true;
-                    config_.getProperty( "enterOnCollection", enterOnCollection );
-                    if ( currentPage_->getSelectedItem( )->leaf || !enterOnCollection ) // Current selection is a game or enterOnCollection is not set
+                    if ( currentPage_->getSelectedItem( )->leaf || !settings_.enterOnCollection ) // Current selection is a game or enterOnCollection is not set
                     {
                         state = RETROFE_HIGHLIGHT_REQUEST;
                     }
@@ -1126,16 +1149,13 @@ bool RetroFE::run( )
                 nextPageItem_ = currentPage_->getSelectedItem( );
                 launchEnter( );
                 CollectionInfoBuilder cib(config_, *metadb_);
-                std::string attractModeSkipPlaylist  = "";
-                std::string lastPlayedSkipCollection = "";
-                int         size = 0;
-                config_.getProperty( "attractModeSkipPlaylist",  attractModeSkipPlaylist );
-                config_.getProperty( "lastPlayedSkipCollection", lastPlayedSkipCollection );
-                config_.getProperty( "lastplayedSize", size );
 
-                if (currentPage_->getPlaylistName( )    != attractModeSkipPlaylist &&
-                    nextPageItem_->collectionInfo->name != lastPlayedSkipCollection)
-                    cib.updateLastPlayedPlaylist( currentPage_->getCollection(), nextPageItem_, size ); // Update last played playlist if not currently in the skip playlist (e.g. settings)
+                if (currentPage_->getPlaylistName( )    != settings_.attractModeSkipPlaylist &&
+                    nextPageItem_->collectionInfo->name != settings_.lastPlayedSkipCollection)
+                {
+                    cib.updateLastPlayedPlaylist( currentPage_->getCollection(), nextPageItem_, settings_.lastplayedSize ); // Update last played playlist if not currently in the skip playlist (e.g. settings)
+                    currentPage_->playlistChanged( );
+                }
 
                 l.LEDBlinky( 3, nextPageItem_->collectionInfo->name, nextPageItem_ );
                 if (l.run(nextPageItem_->collectionInfo->name, nextPageItem_)) // Run and check if we need to reboot
@@ -1197,24 +1217,18 @@ bool RetroFE::run( )
                 }
                 config_.setProperty( "currentCollection", currentPage_->getCollectionName( ) );
 
-                bool rememberMenu = false;
-                config_.getProperty( "rememberMenu", rememberMenu );
-
-                std::string autoPlaylist = "all";
-                config_.getProperty( "autoPlaylist", autoPlaylist );
-
-                if (rememberMenu && lastMenuPlaylists_.find( currentPage_->getCollectionName( ) ) != lastMenuPlaylists_.end( ))
+                if (settings_.rememberMenu && lastMenuPlaylists_.find( currentPage_->getCollectionName( ) ) != lastMenuPlaylists_.end( ))
                 {
                     currentPage_->selectPlaylist( lastMenuPlaylists_[currentPage_->getCollectionName( )] ); // Switch to last playlist
                 }
                 else
                 {
-                    currentPage_->selectPlaylist( autoPlaylist );
-                    if (currentPage_->getPlaylistName() != autoPlaylist )
+                    currentPage_->selectPlaylist( settings_.autoPlaylist );
+                    if (currentPage_->getPlaylistName() != settings_.autoPlaylist )
                         currentPage_->selectPlaylist( "all" );
                 }
 
-                if ( rememberMenu && lastMenuOffsets_.find( currentPage_->getCollectionName( ) ) != lastMenuOffsets_.end( ) )
+                if ( settings_.rememberMenu && lastMenuOffsets_.find( currentPage_->getCollectionName( ) ) != lastMenuOffsets_.end( ) )
                 {
                     currentPage_->setScrollOffsetIndex( lastMenuOffsets_[currentPage_->getCollectionName( )] );
                 }
@@ -1235,9 +1249,7 @@ bool RetroFE::run( )
         case RETROFE_BACK_MENU_ENTER:
             if ( currentPage_->isIdle( ) )
             {
-                bool collectionInputClear = false;
-                config_.getProperty( "collectionInputClear", collectionInputClear );
-                if (  collectionInputClear  )
+                if ( settings_.collectionInputClear )
                 {
                     // Empty event queue
                     SDL_Event e;
@@ -1255,9 +1267,7 @@ bool RetroFE::run( )
             {
                 lastMenuOffsets_[currentPage_->getCollectionName( )]   = currentPage_->getScrollOffsetIndex( );
                 lastMenuPlaylists_[currentPage_->getCollectionName( )] = currentPage_->getPlaylistName( );
-                std::string layoutName;
-                config_.getProperty( "layout", layoutName );
-                PageBuilder pb( layoutName, "layout", config_, &fontcache_, true );
+                PageBuilder pb( settings_.layout, "layout", config_, &fontcache_, true );
                 Page *page = pb.buildPage( );
                 if ( page )
                 {
@@ -1340,32 +1350,22 @@ bool RetroFE::run( )
 
             if ( currentPage_ )
             {
-                if (!splashMode)
+                if (!splashMode && state != RETROFE_NEXT_PAGE_COLLECTION_LOAD) // attract mode must not interrupt a collection build
                 {
                     int attractReturn = attract_.update( deltaTime, *currentPage_ );
                     if (attractReturn == 1) // Change playlist
                     {
                         attract_.reset( attract_.isSet( ) );
 
-                        bool cyclePlaylist = false;
-                        config_.getProperty( "attractModeCyclePlaylist", cyclePlaylist );
-
-                        std::string cycleString;
-                        config_.getProperty( "cyclePlaylist", cycleString );
-                        std::vector<std::string> cycleVector;
-                        Utils::listToVector( cycleString, cycleVector, ',' );
-
-                        if ( cyclePlaylist )
-                            currentPage_->nextCyclePlaylist( cycleVector );
+                        if ( settings_.attractModeCyclePlaylist )
+                            currentPage_->nextCyclePlaylist( settings_.cyclePlaylist );
                         else
                             currentPage_->nextPlaylist( );
 
-                        std::string attractModeSkipPlaylist = "";
-                        config_.getProperty( "attractModeSkipPlaylist", attractModeSkipPlaylist );
-                        if (currentPage_->getPlaylistName( ) == attractModeSkipPlaylist)
+                        if (currentPage_->getPlaylistName( ) == settings_.attractModeSkipPlaylist)
                         {
-                            if ( cyclePlaylist )
-                                currentPage_->nextCyclePlaylist( cycleVector );
+                            if ( settings_.attractModeCyclePlaylist )
+                                currentPage_->nextCyclePlaylist( settings_.cyclePlaylist );
                             else
                                 currentPage_->nextPlaylist( );
                         }
@@ -1418,8 +1418,7 @@ bool RetroFE::run( )
 bool RetroFE::back(bool &exit)
 {
     bool canGoBack  = false;
-    bool exitOnBack = false;
-    config_.getProperty( "exitOnFirstPageBack", exitOnBack );
+    bool exitOnBack = settings_.exitOnFirstPageBack;
     exit = false;
 
     if ( currentPage_->getMenuDepth( ) <= 1 && pages_.empty( ) )
@@ -1505,9 +1504,7 @@ RetroFE::RETROFE_STATE RetroFE::processUserInput( Page *page )
                  (input_.keystate(UserInput::KeyCodeCollectionLeft) && (!page->isHorizontalScroll( ) || !input_.keystate(UserInput::KeyCodeLeft))))
         {
             attract_.reset( );
-            bool backOnCollection = false;
-            config_.getProperty( "backOnCollection", backOnCollection );
-            if ( page->getMenuDepth( ) == 1 || !backOnCollection )
+            if ( page->getMenuDepth( ) == 1 || !settings_.backOnCollection )
                 state = RETROFE_COLLECTION_UP_REQUEST;
             else
                 state = RETROFE_BACK_REQUEST;
@@ -1517,9 +1514,7 @@ RetroFE::RETROFE_STATE RetroFE::processUserInput( Page *page )
                  (input_.keystate(UserInput::KeyCodeCollectionRight) && (!page->isHorizontalScroll( ) || !input_.keystate(UserInput::KeyCodeRight))))
         {
             attract_.reset( );
-            bool backOnCollection = false;
-            config_.getProperty( "backOnCollection", backOnCollection );
-            if ( page->getMenuDepth( ) == 1 || !backOnCollection )
+            if ( page->getMenuDepth( ) == 1 || !settings_.backOnCollection )
                 state = RETROFE_COLLECTION_DOWN_REQUEST;
             else
                 state = RETROFE_BACK_REQUEST;
@@ -1542,9 +1537,7 @@ RetroFE::RETROFE_STATE RetroFE::processUserInput( Page *page )
         else if (input_.keystate(UserInput::KeyCodeLetterUp))
         {
             attract_.reset( );
-            bool cfwLetterSub;
-            config_.getProperty( "cfwLetterSub", cfwLetterSub );
-            if (cfwLetterSub && page->hasSubs())
+            if (settings_.cfwLetterSub && page->hasSubs())
                 page->cfwLetterSubScroll(Page::ScrollDirectionBack);
             else
                 page->letterScroll(Page::ScrollDirectionBack);
@@ -1554,9 +1547,7 @@ RetroFE::RETROFE_STATE RetroFE::processUserInput( Page *page )
         else if (input_.keystate(UserInput::KeyCodeLetterDown))
         {
             attract_.reset( );
-            bool cfwLetterSub;
-            config_.getProperty( "cfwLetterSub", cfwLetterSub );
-            if (cfwLetterSub && page->hasSubs())
+            if (settings_.cfwLetterSub && page->hasSubs())
                 page->cfwLetterSubScroll(Page::ScrollDirectionForward);
             else
                 page->letterScroll(Page::ScrollDirectionForward);
@@ -1592,22 +1583,14 @@ RetroFE::RETROFE_STATE RetroFE::processUserInput( Page *page )
                   input_.keystate(UserInput::KeyCodeNextCyclePlaylist) )
         {
             attract_.reset( );
-            std::string cycleString;
-            config_.getProperty( "cyclePlaylist", cycleString );
-            std::vector<std::string> cycleVector;
-            Utils::listToVector( cycleString, cycleVector, ',' );
-            page->nextCyclePlaylist( cycleVector );
+            page->nextCyclePlaylist( settings_.cyclePlaylist );
             state = RETROFE_PLAYLIST_REQUEST;
         }
 
         else if ( input_.keystate(UserInput::KeyCodePrevCyclePlaylist) )
         {
             attract_.reset( );
-            std::string cycleString;
-            config_.getProperty( "cyclePlaylist", cycleString );
-            std::vector<std::string> cycleVector;
-            Utils::listToVector( cycleString, cycleVector, ',' );
-            page->prevCyclePlaylist( cycleVector );
+            page->prevCyclePlaylist( settings_.cyclePlaylist );
             state = RETROFE_PLAYLIST_REQUEST;
         }
 
@@ -1712,16 +1695,13 @@ RetroFE::RETROFE_STATE RetroFE::processUserInput( Page *page )
                 else
                 {
                     CollectionInfoBuilder cib(config_, *metadb_);
-                    std::string attractModeSkipPlaylist  = "";
-                    std::string lastPlayedSkipCollection = "";
-                    int         size = 0;
-                    config_.getProperty( "attractModeSkipPlaylist",  attractModeSkipPlaylist );
-                    config_.getProperty( "lastPlayedSkipCollection", lastPlayedSkipCollection );
-                    config_.getProperty("lastplayedCollectionSize", size);
-    
-                    if (currentPage_->getPlaylistName( )    != attractModeSkipPlaylist &&
-                        nextPageItem_->collectionInfo->name != lastPlayedSkipCollection)
-                        cib.updateLastPlayedPlaylist( currentPage_->getCollection(), nextPageItem_, size ); // Update last played playlist if not currently in the skip playlist (e.g. settings)
+
+                    if (currentPage_->getPlaylistName( )    != settings_.attractModeSkipPlaylist &&
+                        nextPageItem_->collectionInfo->name != settings_.lastPlayedSkipCollection)
+                    {
+                        cib.updateLastPlayedPlaylist( currentPage_->getCollection(), nextPageItem_, settings_.lastplayedCollectionSize ); // Update last played playlist if not currently in the skip playlist (e.g. settings)
+                        currentPage_->playlistChanged( );
+                    }
                     state = RETROFE_NEXT_PAGE_REQUEST;
                 }
             }
@@ -1802,11 +1782,7 @@ RetroFE::RETROFE_STATE RetroFE::processUserInput( Page *page )
 // Load a page
 Page *RetroFE::loadPage( )
 {
-    std::string layoutName;
-
-    config_.getProperty( "layout", layoutName );
-
-    PageBuilder pb( layoutName, "layout", config_, &fontcache_ );
+    PageBuilder pb( settings_.layout, "layout", config_, &fontcache_ );
     Page *page = pb.buildPage( );
 
     if ( !page )
@@ -1821,10 +1797,7 @@ Page *RetroFE::loadPage( )
 // Load the splash page
 Page *RetroFE::loadSplashPage( )
 {
-    std::string layoutName;
-    config_.getProperty( "layout", layoutName );
-
-    PageBuilder pb( layoutName, "splash", config_, &fontcache_ );
+    PageBuilder pb( settings_.layout, "splash", config_, &fontcache_ );
     Page * page = pb.buildPage( );
     page->start( );
 
@@ -1836,9 +1809,15 @@ Page *RetroFE::loadSplashPage( )
 CollectionInfo *RetroFE::getCollection(std::string collectionName)
 {
 
+    // Reuse the collection if it was built before and nothing changed since
+    CollectionInfo *cached = CollectionCache::acquire( collectionName );
+    if ( cached )
+    {
+        return cached;
+    }
+
     // Check if subcollections should be merged or split
-    bool subsSplit = false;
-    config_.getProperty( "subsSplit", subsSplit );
+    bool subsSplit = settings_.subsSplit;
 
     // Build the collection
     CollectionInfoBuilder cib(config_, *metadb_);
@@ -1853,7 +1832,8 @@ CollectionInfo *RetroFE::getCollection(std::string collectionName)
     dp = opendir( path.c_str( ) );
 
     // Loading sub collection files
-    while ( (dirp = readdir( dp )) != NULL )
+    std::vector<std::string> subcollections;
+    while ( dp != NULL && (dirp = readdir( dp )) != NULL )
     {
         std::string file = dirp->d_name;
 
@@ -1868,25 +1848,24 @@ CollectionInfo *RetroFE::getCollection(std::string collectionName)
             if ( file.compare( start, comparator.length( ), comparator ) == 0 )
             {
                 Logger::write( Logger::ZONE_INFO, "RetroFE", "Loading subcollection into menu: " + basename );
-
-                CollectionInfo *subcollection = cib.buildCollection( basename, collectionName );
-                collection->addSubcollection( subcollection );
-                subcollection->subsSplit = subsSplit;
-                cib.injectMetadata( subcollection );
-                collection->hasSubs = true;
+                subcollections.push_back( basename );
             }
         }
     }
     if (dp) closedir( dp );
 
+    cib.addSubcollections( collection, subcollections, subsSplit );
+
     bool menuSort = true;
     config_.getProperty( "collections." + collectionName + ".list.menuSort", menuSort );
+    config_.getProperty( "sortIgnoreThe", collection->sortIgnoreThe );
 
     if (menuSort)
         collection->sortItems( );
 
     MenuParser mp;
     mp.buildMenuItems( collection, menuSort);
+    collection->buildSortKeys( );
 
     cib.addPlaylists( collection );
     collection->sortPlaylists( );
@@ -1945,10 +1924,77 @@ CollectionInfo *RetroFE::getCollection(std::string collectionName)
         }
     }
 
+    CollectionCache::track( collection );
+
     return collection;
 }
 
 
+// Start building a collection on a worker thread
+void RetroFE::startCollectionLoad( std::string collectionName, bool menu )
+{
+
+    collectionLoadName_ = collectionName;
+    collectionLoadMenu_ = menu;
+    collectionLoadInfo_ = NULL;
+    SDL_AtomicSet( &collectionLoadDone_, 0 );
+
+    collectionThread_ = SDL_CreateThread( loadCollection, "RetroFECollection", (void *)this );
+
+    // Fall back to building it in place
+    if ( !collectionThread_ )
+    {
+        Logger::write( Logger::ZONE_WARNING, "RetroFE", "Could not create collection thread: " + std::string( SDL_GetError( ) ) );
+        loadCollection( (void *)this );
+    }
+
+}
+
+
+// Check if the collection is built; hands it over once it is
+bool RetroFE::collectionLoaded( CollectionInfo *&info )
+{
+
+    if ( !SDL_AtomicGet( &collectionLoadDone_ ) )
+    {
+        return false;
+    }
+
+    if ( collectionThread_ )
+    {
+        SDL_WaitThread( collectionThread_, NULL );
+        collectionThread_ = NULL;
+    }
+
+    info                = collectionLoadInfo_;
+    collectionLoadInfo_ = NULL;
+
+    return true;
+
+}
+
+
+// Collection thread
+int RetroFE::loadCollection( void *context )
+{
+
+    RetroFE *instance = static_cast<RetroFE *>(context);
+
+    Logger::write( Logger::ZONE_INFO, "RetroFE", "Building collection " + instance->collectionLoadName_ );
+
+    if ( instance->collectionLoadMenu_ )
+        instance->collectionLoadInfo_ = instance->getMenuCollection( instance->collectionLoadName_ );
+    else
+        instance->collectionLoadInfo_ = instance->getCollection( instance->collectionLoadName_ );
+
+    // publishes collectionLoadInfo_ to the main thread
+    SDL_AtomicSet( &instance->collectionLoadDone_, 1 );
+
+    return 0;
+
+}
+
+
 // Load a menu
 CollectionInfo *RetroFE::getMenuCollection( std::string collectionName )
 {
@@ -1974,6 +2020,7 @@ CollectionInfo *RetroFE::getMenuCollection( std::string collectionName )
         collection->items.push_back( *it );
     }
     collection->playlists["all"] = &collection->items;
+    collection->buildSortKeys( );
     return collection;
 }
 
@@ -20,6 +20,7 @@
 #include "Control/UserInput.h"
 #include "Database/DB.h"
 #include "Database/MetadataDatabase.h"
+#include "Database/RuntimeSettings.h"
 #include "Execute/AttractMode.h"
 #include "Graphics/FontCache.h"
 #include "Video/IVideo.h"
@@ -62,6 +63,7 @@ private:
         RETROFE_LOAD_ART,
         RETROFE_ENTER,
         RETROFE_SPLASH_EXIT,
+        RETROFE_SPLASH_COLLECTION_LOAD,
         RETROFE_PLAYLIST_REQUEST,
         RETROFE_PLAYLIST_EXIT,
         RETROFE_PLAYLIST_LOAD_ART,
@@ -76,6 +78,7 @@ private:
         RETROFE_HIGHLIGHT_ENTER,
         RETROFE_NEXT_PAGE_REQUEST,
         RETROFE_NEXT_PAGE_MENU_EXIT,
+        RETROFE_NEXT_PAGE_COLLECTION_LOAD,
         RETROFE_NEXT_PAGE_MENU_LOAD_ART,
         RETROFE_NEXT_PAGE_MENU_ENTER,
         RETROFE_COLLECTION_UP_REQUEST,
@@ -117,9 +120,13 @@ private:
     void            update( float dt, bool scrollActive );
     CollectionInfo *getCollection( std::string collectionName );
     CollectionInfo *getMenuCollection( std::string collectionName );
+    void            startCollectionLoad( std::string collectionName, bool menu );
+    bool            collectionLoaded( CollectionInfo *&info );
+    static int      loadCollection( void *context );
 	void            saveRetroFEState( );
 
     Configuration     &config_;
+    RuntimeSettings    settings_;
     DB                *db_;
     MetadataDatabase  *metadb_;
     UserInput          input_;
@@ -139,6 +146,13 @@ private:
 	bool               reboot_;
 	std::string        firstPlaylist_;
 
+    // collection being built on a worker thread while the page keeps animating
+    SDL_Thread     *collectionThread_;
+    std::string     collectionLoadName_;
+    bool            collectionLoadMenu_;
+    CollectionInfo *collectionLoadInfo_;
+    SDL_atomic_t    collectionLoadDone_;
+
     std::map<std::string, unsigned int> lastMenuOffsets_;
     std::map<std::string, std::string>  lastMenuPlaylists_;
 };
@@ -30,6 +30,13 @@ std::vector<int>            SDL::windowHeight_;
 std::vector<bool>           SDL::fullscreen_;
 std::vector<int>            SDL::rotation_;
 std::vector<bool>           SDL::mirror_;
+std::vector<SDL::Transform_S> SDL::transform_;
+bool                        SDL::textBatching_ = true;
+std::vector<bool>           SDL::batchText_;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+std::vector<SDL_Vertex>     SDL::vertices_;
+std::vector<int>            SDL::indices_;
+#endif
 int                         SDL::numScreens_ = 1;
 int                         SDL::numDisplays_ = 1;
 
@@ -64,6 +71,8 @@ bool SDL::initialize( Configuration &config )
         }
     }
 
+    config.getProperty( "textBatching", textBatching_ );
+
     // check for a few other necessary Configurations
     config.getProperty( "numScreens", numScreens_ );
 
@@ -218,6 +227,19 @@ bool SDL::initialize( Configuration &config )
         }
     }
 
+    transform_.resize( numScreens_ );
+    updateTransforms( );
+
+    // The software renderer draws a text no faster as geometry, and samples
+    // the glyph edges differently than it does for a copy
+    for ( int i = 0; i < numScreens_; ++i )
+    {
+        SDL_RendererInfo info;
+        batchText_.push_back( textBatching_ && renderer_[i] &&
+                              SDL_GetRendererInfo( renderer_[i], &info ) == 0 &&
+                              !(info.flags & SDL_RENDERER_SOFTWARE) );
+    }
+
     if ( SDL_SetHint( SDL_HINT_RENDER_SCALE_QUALITY, "1") != SDL_TRUE )
     {
         Logger::write( Logger::ZONE_ERROR, "SDL", "Improve scale quality. Continuing with low-quality settings." );
@@ -296,6 +318,8 @@ bool SDL::deInitialize( )
     windowWidth_.clear( );
     windowHeight_.clear( );
     fullscreen_.clear( );
+    transform_.clear( );
+    batchText_.clear( );
 
     SDL_ShowCursor( SDL_TRUE );
 
@@ -326,6 +350,58 @@ SDL_Window* SDL::getWindow( int index )
 }
 
 
+// Refresh the window sizes and the per-monitor drawing state; called once
+// per frame before drawing so resized windows are picked up.
+void SDL::updateTransforms( )
+{
+    for ( int i = 0; i < numScreens_ && i < static_cast<int>( transform_.size( ) ); ++i )
+    {
+        if ( !window_[i] || i >= static_cast<int>( rotation_.size( ) ) )
+            continue;
+
+        int width  = 0;
+        int height = 0;
+        SDL_GetWindowSize( window_[i], &width, &height );
+        windowWidth_[i]  = width;
+        windowHeight_[i] = height;
+
+        Transform_S &transform = transform_[i];
+        if ( transform.windowWidth != width || transform.windowHeight != height )
+        {
+            transform.windowWidth  = width;
+            transform.windowHeight = height;
+            transform.layoutWidth  = 0;
+            transform.layoutHeight = 0;
+        }
+        transform.rotation = rotation_[i];
+        transform.mirror   = mirror_[i];
+        transform.offsetX  = fullscreen_[i] ? (displayWidth_[i] - width)/2 : 0;
+        transform.offsetY  = fullscreen_[i] ? (displayHeight_[i] - height)/2 : 0;
+    }
+}
+
+
+// Compute the layout to window scale factors of a monitor
+void SDL::updateScale( int index, int layoutWidth, int layoutHeight )
+{
+    Transform_S &transform = transform_[index];
+
+    transform.layoutWidth  = layoutWidth;
+    transform.layoutHeight = layoutHeight;
+    transform.scaleX       = (float)transform.windowWidth  / (float)layoutWidth;
+    transform.scaleY       = (float)transform.windowHeight / (float)layoutHeight;
+
+    if ( transform.rotation % 2 == 1 ) // 90 or 270 degree rotation; change scale factors
+    {
+        transform.scaleX = (float)transform.windowHeight / (float)layoutWidth;
+        transform.scaleY = (float)transform.windowWidth  / (float)layoutHeight;
+    }
+
+    if ( transform.mirror )
+        transform.scaleY /= 2;
+}
+
+
 // Render a copy of a texture
 bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect *dest, ViewInfo &viewInfo, int layoutWidth, int layoutHeight )
 {
@@ -334,22 +410,20 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
     if ( alpha == 0 || viewInfo.Monitor >= numScreens_ || !renderer_[viewInfo.Monitor] )
         return true;
 
-    SDL_GetWindowSize( getWindow( viewInfo.Monitor ), &windowWidth_[viewInfo.Monitor], &windowHeight_[viewInfo.Monitor] );
+    Transform_S &transform = transform_[viewInfo.Monitor];
+    if ( transform.layoutWidth != layoutWidth || transform.layoutHeight != layoutHeight )
+        updateScale( viewInfo.Monitor, layoutWidth, layoutHeight );
 
-    float scaleX = (float)windowWidth_[viewInfo.Monitor]  / (float)layoutWidth;
-    float scaleY = (float)windowHeight_[viewInfo.Monitor] / (float)layoutHeight;
-
-    if ( rotation_[viewInfo.Monitor] % 2 == 1 ) // 90 or 270 degree rotation; change scale factors
-    {
-        scaleX = (float)windowHeight_[viewInfo.Monitor] / (float)layoutWidth;
-        scaleY = (float)windowWidth_[viewInfo.Monitor]  / (float)layoutHeight;
-    }
-
-    if ( mirror_[viewInfo.Monitor] )
-        scaleY /= 2;
+    SDL_Renderer *renderer     = renderer_[viewInfo.Monitor];
+    int           windowWidth  = transform.windowWidth;
+    int           windowHeight = transform.windowHeight;
+    int           rotation     = transform.rotation;
+    bool          mirror       = transform.mirror;
+    float         scaleX       = transform.scaleX;
+    float         scaleY       = transform.scaleY;
 
     // Don't print outside the screen in mirror mode
-    if ( mirror_[viewInfo.Monitor] && (viewInfo.ContainerWidth < 0 || viewInfo.ContainerHeight < 0) )
+    if ( mirror && (viewInfo.ContainerWidth < 0 || viewInfo.ContainerHeight < 0) )
     {
         viewInfo.ContainerX      = 0;
         viewInfo.ContainerY      = 0;
@@ -369,16 +443,8 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
     dstRect.w = dest->w;
     dstRect.h = dest->h;
 
-    if ( fullscreen_[viewInfo.Monitor] )
-    {
-        dstRect.x = dest->x + (displayWidth_[viewInfo.Monitor] - windowWidth_[viewInfo.Monitor])/2;
-        dstRect.y = dest->y + (displayHeight_[viewInfo.Monitor] - windowHeight_[viewInfo.Monitor])/2;
-    }
-    else
-    {
-        dstRect.x = dest->x;
-        dstRect.y = dest->y;
-    }
+    dstRect.x = dest->x + transform.offsetX;
+    dstRect.y = dest->y + transform.offsetY;
 
     // Create the base fields to check against the container.
     if (src)
@@ -462,27 +528,27 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
     }
 
     double angle = viewInfo.Angle;
-    if ( !mirror_[viewInfo.Monitor] )
-        angle += rotation_[viewInfo.Monitor] * 90;
+    if ( !mirror )
+        angle += rotation * 90;
 
     dstRect.x = (int)(dstRect.x*scaleX);
     dstRect.y = (int)(dstRect.y*scaleY);
     dstRect.w = (int)(dstRect.w*scaleX);
     dstRect.h = (int)(dstRect.h*scaleY);
 
-    if ( mirror_[viewInfo.Monitor] )
+    if ( mirror )
     {
-        if ( rotation_[viewInfo.Monitor] % 2 == 0 )
+        if ( rotation % 2 == 0 )
         {
             if ( srcRect.h > 0 && srcRect.w > 0 )
             {
-                dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
+                dstRect.y += windowHeight / 2;
                 SDL_SetTextureAlphaMod( texture, static_cast<char>( alpha * 255 ) );
-                SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
+                dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                dstRect.y = windowHeight - dstRect.y - dstRect.h;
                 angle    += 180;
-                SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
+                SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
             }
         }
         else
@@ -490,42 +556,42 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
             if ( srcRect.h > 0 && srcRect.w > 0 )
             {
                 int tmp   = dstRect.x;
-                dstRect.x = windowWidth_[viewInfo.Monitor]/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
+                dstRect.x = windowWidth/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
                 dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
                 angle    += 90;
                 SDL_SetTextureAlphaMod( texture, static_cast<char>( alpha * 255 ) );
-                SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
+                dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                dstRect.y = windowHeight - dstRect.y - dstRect.h;
                 angle    += 180;
-                SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
+                SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
             }
         }
     }
     else
     {
-        if ( rotation_[viewInfo.Monitor] == 1 ) // 90 degree rotation
+        if ( rotation == 1 ) // 90 degree rotation
         {
             int tmp   = dstRect.x;
-            dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h/2 - dstRect.w/2;
+            dstRect.x = windowWidth - dstRect.y - dstRect.h/2 - dstRect.w/2;
             dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
         }
-        if ( rotation_[viewInfo.Monitor] == 2 ) // 180 degree rotation
+        if ( rotation == 2 ) // 180 degree rotation
         {
-            dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-            dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+            dstRect.x = windowWidth - dstRect.x - dstRect.w;
+            dstRect.y = windowHeight - dstRect.y - dstRect.h;
         }
-        if ( rotation_[viewInfo.Monitor] == 3 ) // 270 degree rotation
+        if ( rotation == 3 ) // 270 degree rotation
         {
             int tmp   = dstRect.x;
             dstRect.x = dstRect.y + dstRect.h/2 - dstRect.w/2;
-            dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h/2 - dstRect.w/2;
+            dstRect.y = windowHeight - tmp - dstRect.h/2 - dstRect.w/2;
         }
     
         if ( srcRect.h > 0 && srcRect.w > 0 )
         {
             SDL_SetTextureAlphaMod( texture, static_cast<char>( alpha * 255 ) );
-            SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
+            SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_NONE );
         }
     }
 
@@ -547,7 +613,7 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
     dstRectCopy.w = dstRectOrig.w;
     dstRectCopy.h = dstRectOrig.h;
 
-    if ( viewInfo.Reflection.find("top") != std::string::npos )
+    if ( viewInfo.Reflection & ViewInfo::ReflectionTop )
     {
         dstRect.h     = static_cast<unsigned int>( static_cast<float>(dstRect.h ) * viewInfo.ReflectionScale);
         dstRect.y     = dstRect.y - dstRect.h - viewInfo.ReflectionDistance;
@@ -595,27 +661,27 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
         }
 
         angle = viewInfo.Angle;
-        if ( !mirror_[viewInfo.Monitor] )
-            angle += rotation_[viewInfo.Monitor] * 90;
+        if ( !mirror )
+            angle += rotation * 90;
 
         dstRect.x = (int)(dstRect.x*scaleX);
         dstRect.y = (int)(dstRect.y*scaleY);
         dstRect.w = (int)(dstRect.w*scaleX);
         dstRect.h = (int)(dstRect.h*scaleY);
 
-        if ( mirror_[viewInfo.Monitor] )
+        if ( mirror )
         {
-            if ( rotation_[viewInfo.Monitor] % 2 == 0 )
+            if ( rotation % 2 == 0 )
             {
                 if ( srcRect.h > 0 && srcRect.w > 0 )
                 {
-                    dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
+                    dstRect.y += windowHeight / 2;
                     SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
-                    dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                    dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                    dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                    dstRect.y = windowHeight - dstRect.y - dstRect.h;
                     angle    += 180;
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
                 }
             }
             else
@@ -623,42 +689,42 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
                 if ( srcRect.h > 0 && srcRect.w > 0 )
                 {
                     int tmp   = dstRect.x;
-                    dstRect.x = windowWidth_[viewInfo.Monitor]/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
+                    dstRect.x = windowWidth/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
                     dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
                     angle    += 90;
                     SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
-                    dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                    dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                    dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                    dstRect.y = windowHeight - dstRect.y - dstRect.h;
                     angle    += 180;
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
                 }
             }
         }
         else
         {
-            if ( rotation_[viewInfo.Monitor] == 1 ) // 90 degree rotation
+            if ( rotation == 1 ) // 90 degree rotation
             {
                 int tmp   = dstRect.x;
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h/2 - dstRect.w/2;
+                dstRect.x = windowWidth - dstRect.y - dstRect.h/2 - dstRect.w/2;
                 dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
             }
-            if ( rotation_[viewInfo.Monitor] == 2 ) // 180 degree rotation
+            if ( rotation == 2 ) // 180 degree rotation
             {
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                dstRect.y = windowHeight - dstRect.y - dstRect.h;
             }
-            if ( rotation_[viewInfo.Monitor] == 3 ) // 270 degree rotation
+            if ( rotation == 3 ) // 270 degree rotation
             {
                 int tmp   = dstRect.x;
                 dstRect.x = dstRect.y + dstRect.h/2 - dstRect.w/2;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h/2 - dstRect.w/2;
+                dstRect.y = windowHeight - tmp - dstRect.h/2 - dstRect.w/2;
             }
         
             if ( srcRect.h > 0 && srcRect.w > 0 )
             {
                 SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
             }
         }
     }
@@ -681,7 +747,7 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
     dstRectCopy.w = dstRectOrig.w;
     dstRectCopy.h = dstRectOrig.h;
 
-    if ( viewInfo.Reflection.find("bottom") != std::string::npos )
+    if ( viewInfo.Reflection & ViewInfo::ReflectionBottom )
     {
         dstRect.y     = dstRect.y + dstRect.h + viewInfo.ReflectionDistance;
         dstRect.h     = static_cast<unsigned int>( static_cast<float>(dstRect.h ) * viewInfo.ReflectionScale);
@@ -729,27 +795,27 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
         }
 
         angle = viewInfo.Angle;
-        if ( !mirror_[viewInfo.Monitor] )
-            angle += rotation_[viewInfo.Monitor] * 90;
+        if ( !mirror )
+            angle += rotation * 90;
 
         dstRect.x = (int)(dstRect.x*scaleX);
         dstRect.y = (int)(dstRect.y*scaleY);
         dstRect.w = (int)(dstRect.w*scaleX);
         dstRect.h = (int)(dstRect.h*scaleY);
 
-        if ( mirror_[viewInfo.Monitor] )
+        if ( mirror )
         {
-            if ( rotation_[viewInfo.Monitor] % 2 == 0 )
+            if ( rotation % 2 == 0 )
             {
                 if ( srcRect.h > 0 && srcRect.w > 0 )
                 {
-                    dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
+                    dstRect.y += windowHeight / 2;
                     SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
-                    dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                    dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                    dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                    dstRect.y = windowHeight - dstRect.y - dstRect.h;
                     angle    += 180;
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
                 }
             }
             else
@@ -757,42 +823,42 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
                 if ( srcRect.h > 0 && srcRect.w > 0 )
                 {
                     int tmp   = dstRect.x;
-                    dstRect.x = windowWidth_[viewInfo.Monitor]/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
+                    dstRect.x = windowWidth/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
                     dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
                     angle    += 90;
                     SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
-                    dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                    dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                    dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                    dstRect.y = windowHeight - dstRect.y - dstRect.h;
                     angle    += 180;
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
                 }
             }
         }
         else
         {
-            if ( rotation_[viewInfo.Monitor] == 1 ) // 90 degree rotation
+            if ( rotation == 1 ) // 90 degree rotation
             {
                 int tmp   = dstRect.x;
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h/2 - dstRect.w/2;
+                dstRect.x = windowWidth - dstRect.y - dstRect.h/2 - dstRect.w/2;
                 dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
             }
-            if ( rotation_[viewInfo.Monitor] == 2 ) // 180 degree rotation
+            if ( rotation == 2 ) // 180 degree rotation
             {
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                dstRect.y = windowHeight - dstRect.y - dstRect.h;
             }
-            if ( rotation_[viewInfo.Monitor] == 3 ) // 270 degree rotation
+            if ( rotation == 3 ) // 270 degree rotation
             {
                 int tmp   = dstRect.x;
                 dstRect.x = dstRect.y + dstRect.h/2 - dstRect.w/2;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h/2 - dstRect.w/2;
+                dstRect.y = windowHeight - tmp - dstRect.h/2 - dstRect.w/2;
             }
         
             if ( srcRect.h > 0 && srcRect.w > 0 )
             {
                 SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
+                SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_VERTICAL );
             }
         }
     }
@@ -815,7 +881,7 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
     dstRectCopy.w = dstRectOrig.w;
     dstRectCopy.h = dstRectOrig.h;
 
-    if ( viewInfo.Reflection.find("left") != std::string::npos )
+    if ( viewInfo.Reflection & ViewInfo::ReflectionLeft )
     {
         dstRect.w     = static_cast<unsigned int>( static_cast<float>(dstRect.w ) * viewInfo.ReflectionScale);
         dstRect.x     = dstRect.x - dstRect.w - viewInfo.ReflectionDistance;
@@ -863,27 +929,27 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
         }
 
         angle = viewInfo.Angle;
-        if ( !mirror_[viewInfo.Monitor] )
-            angle += rotation_[viewInfo.Monitor] * 90;
+        if ( !mirror )
+            angle += rotation * 90;
 
         dstRect.x = (int)(dstRect.x*scaleX);
         dstRect.y = (int)(dstRect.y*scaleY);
         dstRect.w = (int)(dstRect.w*scaleX);
         dstRect.h = (int)(dstRect.h*scaleY);
 
-        if ( mirror_[viewInfo.Monitor] )
+        if ( mirror )
         {
-            if ( rotation_[viewInfo.Monitor] % 2 == 0 )
+            if ( rotation % 2 == 0 )
             {
                 if ( srcRect.h > 0 && srcRect.w > 0 )
                 {
-                    dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
+                    dstRect.y += windowHeight / 2;
                     SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
-                    dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                    dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                    dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                    dstRect.y = windowHeight - dstRect.y - dstRect.h;
                     angle    += 180;
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
                 }
             }
             else
@@ -891,42 +957,42 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
                 if ( srcRect.h > 0 && srcRect.w > 0 )
                 {
                     int tmp   = dstRect.x;
-                    dstRect.x = windowWidth_[viewInfo.Monitor]/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
+                    dstRect.x = windowWidth/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
                     dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
                     angle    += 90;
                     SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
-                    dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                    dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                    dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                    dstRect.y = windowHeight - dstRect.y - dstRect.h;
                     angle    += 180;
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
                 }
             }
         }
         else
         {
-            if ( rotation_[viewInfo.Monitor] == 1 ) // 90 degree rotation
+            if ( rotation == 1 ) // 90 degree rotation
             {
                 int tmp   = dstRect.x;
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h/2 - dstRect.w/2;
+                dstRect.x = windowWidth - dstRect.y - dstRect.h/2 - dstRect.w/2;
                 dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
             }
-            if ( rotation_[viewInfo.Monitor] == 2 ) // 180 degree rotation
+            if ( rotation == 2 ) // 180 degree rotation
             {
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                dstRect.y = windowHeight - dstRect.y - dstRect.h;
             }
-            if ( rotation_[viewInfo.Monitor] == 3 ) // 270 degree rotation
+            if ( rotation == 3 ) // 270 degree rotation
             {
                 int tmp   = dstRect.x;
                 dstRect.x = dstRect.y + dstRect.h/2 - dstRect.w/2;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h/2 - dstRect.w/2;
+                dstRect.y = windowHeight - tmp - dstRect.h/2 - dstRect.w/2;
             }
         
             if ( srcRect.h > 0 && srcRect.w > 0 )
             {
                 SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
             }
         }
     }
@@ -949,7 +1015,7 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
     dstRectCopy.w = dstRectOrig.w;
     dstRectCopy.h = dstRectOrig.h;
 
-    if ( viewInfo.Reflection.find("right") != std::string::npos )
+    if ( viewInfo.Reflection & ViewInfo::ReflectionRight )
     {
         dstRect.x     = dstRect.x + dstRect.w + viewInfo.ReflectionDistance;
         dstRect.w     = static_cast<unsigned int>( static_cast<float>(dstRect.w ) * viewInfo.ReflectionScale);
@@ -997,27 +1063,27 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
         }
 
         angle = viewInfo.Angle;
-        if ( !mirror_[viewInfo.Monitor] )
-            angle += rotation_[viewInfo.Monitor] * 90;
+        if ( !mirror )
+            angle += rotation * 90;
 
         dstRect.x = (int)(dstRect.x*scaleX);
         dstRect.y = (int)(dstRect.y*scaleY);
         dstRect.w = (int)(dstRect.w*scaleX);
         dstRect.h = (int)(dstRect.h*scaleY);
 
-        if ( mirror_[viewInfo.Monitor] )
+        if ( mirror )
         {
-            if ( rotation_[viewInfo.Monitor] % 2 == 0 )
+            if ( rotation % 2 == 0 )
             {
                 if ( srcRect.h > 0 && srcRect.w > 0 )
                 {
-                    dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
+                    dstRect.y += windowHeight / 2;
                     SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
-                    dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                    dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                    dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                    dstRect.y = windowHeight - dstRect.y - dstRect.h;
                     angle    += 180;
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
                 }
             }
             else
@@ -1025,45 +1091,180 @@ bool SDL::renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect
                 if ( srcRect.h > 0 && srcRect.w > 0 )
                 {
                     int tmp   = dstRect.x;
-                    dstRect.x = windowWidth_[viewInfo.Monitor]/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
+                    dstRect.x = windowWidth/2 - dstRect.y - dstRect.h/2 - dstRect.w/2;
                     dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
                     angle    += 90;
                     SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
-                    dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                    dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                    dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                    dstRect.y = windowHeight - dstRect.y - dstRect.h;
                     angle    += 180;
-                    SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                    SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
                 }
             }
         }
         else
         {
-            if ( rotation_[viewInfo.Monitor] == 1 ) // 90 degree rotation
+            if ( rotation == 1 ) // 90 degree rotation
             {
                 int tmp   = dstRect.x;
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h/2 - dstRect.w/2;
+                dstRect.x = windowWidth - dstRect.y - dstRect.h/2 - dstRect.w/2;
                 dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
             }
-            if ( rotation_[viewInfo.Monitor] == 2 ) // 180 degree rotation
+            if ( rotation == 2 ) // 180 degree rotation
             {
-                dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
+                dstRect.x = windowWidth - dstRect.x - dstRect.w;
+                dstRect.y = windowHeight - dstRect.y - dstRect.h;
             }
-            if ( rotation_[viewInfo.Monitor] == 3 ) // 270 degree rotation
+            if ( rotation == 3 ) // 270 degree rotation
             {
                 int tmp   = dstRect.x;
                 dstRect.x = dstRect.y + dstRect.h/2 - dstRect.w/2;
-                dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h/2 - dstRect.w/2;
+                dstRect.y = windowHeight - tmp - dstRect.h/2 - dstRect.w/2;
             }
         
             if ( srcRect.h > 0 && srcRect.w > 0 )
             {
                 SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-                SDL_RenderCopyEx( renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
+                SDL_RenderCopyEx( renderer, texture, &srcRect, &dstRect, angle, NULL, SDL_FLIP_HORIZONTAL );
             }
         }
     }
 
     return true;
 }
+
+
+// Render a batch of texture parts, such as the glyphs of a text, with a
+// single geometry call. This covers the plain case of renderCopy: returns
+// false when the view needs an angle, reflection, container or mirroring
+// (or batching is off for the monitor, or SDL can't draw geometry), so the
+// caller has to copy the parts one by one instead.
+bool SDL::renderGeometry( SDL_Texture *texture, float alpha, const std::vector<SDL_Rect> &src, const std::vector<SDL_Rect> &dest, ViewInfo &viewInfo, int layoutWidth, int layoutHeight )
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+    // Skip rendering if the object is invisible anyway or if renderer does not exist
+    if ( alpha == 0 || viewInfo.Monitor >= numScreens_ || !renderer_[viewInfo.Monitor] )
+        return true;
+
+    if ( !batchText_[viewInfo.Monitor] )
+        return false;
+
+    Transform_S &transform = transform_[viewInfo.Monitor];
+    if ( transform.mirror || viewInfo.Angle != 0 || viewInfo.Reflection != 0 ||
+         (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0) )
+        return false;
+
+    if ( transform.layoutWidth != layoutWidth || transform.layoutHeight != layoutHeight )
+        updateScale( viewInfo.Monitor, layoutWidth, layoutHeight );
+
+    int textureWidth  = 0;
+    int textureHeight = 0;
+    SDL_QueryTexture( texture, NULL, NULL, &textureWidth, &textureHeight );
+    if ( textureWidth <= 0 || textureHeight <= 0 )
+        return true;
+
+    int       windowWidth  = transform.windowWidth;
+    int       windowHeight = transform.windowHeight;
+    int       rotation     = transform.rotation;
+    SDL_Color color        = { 255, 255, 255, static_cast<Uint8>( alpha * 255 ) };
+
+    vertices_.clear( );
+    indices_.clear( );
+
+    for ( unsigned int i = 0; i < src.size( ) && i < dest.size( ); ++i )
+    {
+        const SDL_Rect &srcRect = src[i];
+        if ( srcRect.h <= 0 || srcRect.w <= 0 )
+            continue;
+
+        // Same placement as renderCopy
+        SDL_Rect dstRect;
+        dstRect.x = (int)((dest[i].x + transform.offsetX)*transform.scaleX);
+        dstRect.y = (int)((dest[i].y + transform.offsetY)*transform.scaleY);
+        dstRect.w = (int)(dest[i].w*transform.scaleX);
+        dstRect.h = (int)(dest[i].h*transform.scaleY);
+
+        if ( rotation == 1 ) // 90 degree rotation
+        {
+            int tmp   = dstRect.x;
+            dstRect.x = windowWidth - dstRect.y - dstRect.h/2 - dstRect.w/2;
+            dstRect.y = tmp - dstRect.h/2 + dstRect.w/2;
+        }
+        if ( rotation == 2 ) // 180 degree rotation
+        {
+            dstRect.x = windowWidth - dstRect.x - dstRect.w;
+            dstRect.y = windowHeight - dstRect.y - dstRect.h;
+        }
+        if ( rotation == 3 ) // 270 degree rotation
+        {
+            int tmp   = dstRect.x;
+            dstRect.x = dstRect.y + dstRect.h/2 - dstRect.w/2;
+            dstRect.y = windowHeight - tmp - dstRect.h/2 - dstRect.w/2;
+        }
+
+        // Corners clockwise from the top left, turned around the centre by
+        // the screen rotation like SDL_RenderCopyEx does
+        float centerX    = dstRect.x + dstRect.w / 2.0f;
+        float centerY    = dstRect.y + dstRect.h / 2.0f;
+        float halfWidth  = dstRect.w / 2.0f;
+        float halfHeight = dstRect.h / 2.0f;
+        float cornerX[4] = { -halfWidth, halfWidth, halfWidth, -halfWidth };
+        float cornerY[4] = { -halfHeight, -halfHeight, halfHeight, halfHeight };
+        float u0         = static_cast<float>( srcRect.x ) / textureWidth;
+        float v0         = static_cast<float>( srcRect.y ) / textureHeight;
+        float u1         = static_cast<float>( srcRect.x + srcRect.w ) / textureWidth;
+        float v1         = static_cast<float>( srcRect.y + srcRect.h ) / textureHeight;
+        float cornerU[4] = { u0, u1, u1, u0 };
+        float cornerV[4] = { v0, v0, v1, v1 };
+
+        int first = static_cast<int>( vertices_.size( ) );
+        for ( int c = 0; c < 4; ++c )
+        {
+            float x = cornerX[c];
+            float y = cornerY[c];
+            if ( rotation == 1 )
+            {
+                x = -cornerY[c];
+                y = cornerX[c];
+            }
+            else if ( rotation == 2 )
+            {
+                x = -cornerX[c];
+                y = -cornerY[c];
+            }
+            else if ( rotation == 3 )
+            {
+                x = cornerY[c];
+                y = -cornerX[c];
+            }
+
+            SDL_Vertex vertex;
+            vertex.position.x  = centerX + x;
+            vertex.position.y  = centerY + y;
+            vertex.color       = color;
+            vertex.tex_coord.x = cornerU[c];
+            vertex.tex_coord.y = cornerV[c];
+            vertices_.push_back( vertex );
+        }
+
+        indices_.push_back( first );
+        indices_.push_back( first + 1 );
+        indices_.push_back( first + 2 );
+        indices_.push_back( first );
+        indices_.push_back( first + 2 );
+        indices_.push_back( first + 3 );
+    }
+
+    if ( vertices_.empty( ) )
+        return true;
+
+    return SDL_RenderGeometry( renderer_[viewInfo.Monitor], texture, &vertices_[0], static_cast<int>( vertices_.size( ) ), &indices_[0], static_cast<int>( indices_.size( ) ) ) == 0;
+
+#else
+
+    return false;
+
+#endif
+}
@@ -33,7 +33,9 @@ public:
     static SDL_Renderer *getRenderer( int index );
     static SDL_mutex *getMutex( );
     static SDL_Window *getWindow( int index );
+    static void updateTransforms( );
     static bool renderCopy( SDL_Texture *texture, float alpha, SDL_Rect *src, SDL_Rect *dest, ViewInfo &viewInfo, int layoutWidth, int layoutHeight );
+    static bool renderGeometry( SDL_Texture *texture, float alpha, const std::vector<SDL_Rect> &src, const std::vector<SDL_Rect> &dest, ViewInfo &viewInfo, int layoutWidth, int layoutHeight );
     static int getWindowWidth( int index )
     {
         return (index < numDisplays_ ? windowWidth_[index] : windowWidth_[0]);
@@ -56,6 +58,23 @@ public:
     }
 
 private:
+    // drawing state of a monitor, refreshed every frame by updateTransforms
+    struct Transform_S
+    {
+        int   windowWidth;
+        int   windowHeight;
+        int   offsetX;
+        int   offsetY;
+        int   rotation;
+        bool  mirror;
+        int   layoutWidth;
+        int   layoutHeight;
+        float scaleX;
+        float scaleY;
+    };
+
+    static void updateScale( int index, int layoutWidth, int layoutHeight );
+
     static std::vector<SDL_Window *>   window_;
     static std::vector<SDL_Renderer *> renderer_;
     static SDL_mutex                  *mutex_;
@@ -66,6 +85,13 @@ private:
     static std::vector<bool>           fullscreen_;
     static std::vector<int>            rotation_;
     static std::vector<bool>           mirror_;
+    static std::vector<Transform_S>    transform_;
+    static bool                        textBatching_;
+    static std::vector<bool>           batchText_;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    static std::vector<SDL_Vertex>     vertices_;
+    static std::vector<int>            indices_;
+#endif
     static int                         numScreens_;
     static int                         numDisplays_;
 };
@@ -0,0 +1,81 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "InternedString.h"
+
+const std::string                InternedString::empty_;
+std::unordered_set<std::string> *InternedString::table_ = NULL;
+SDL_mutex                       *InternedString::mutex_ = NULL;
+
+
+// Creates the table and its mutex once; both live until the process exits.
+void InternedString::initialize()
+{
+    if(!mutex_)
+    {
+        mutex_ = SDL_CreateMutex();
+    }
+    if(!table_)
+    {
+        table_ = new std::unordered_set<std::string>();
+    }
+}
+
+
+InternedString::InternedString()
+    : value_(&empty_)
+{
+}
+
+
+InternedString::InternedString(const std::string &value)
+    : value_(intern(value))
+{
+}
+
+
+InternedString &InternedString::operator=(const std::string &value)
+{
+    value_ = intern(value);
+    return *this;
+}
+
+
+InternedString &InternedString::operator=(const char *value)
+{
+    value_ = intern(value);
+    return *this;
+}
+
+
+// Collections are built on worker threads, so lookups are serialized. The
+// set's nodes never move, which keeps the returned pointers valid.
+const std::string *InternedString::intern(const std::string &value)
+{
+    if(value.empty())
+    {
+        return &empty_;
+    }
+
+    SDL_LockMutex(mutex_);
+    if(!table_)
+    {
+        table_ = new std::unordered_set<std::string>();
+    }
+    const std::string *interned = &*table_->insert(value).first;
+    SDL_UnlockMutex(mutex_);
+
+    return interned;
+}
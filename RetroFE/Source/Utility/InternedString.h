@@ -0,0 +1,60 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <unordered_set>
+
+// A string kept once in a process-wide table and shared by every holder of
+// an equal value. Item metadata such as genre, year or manufacturer takes a
+// handful of distinct values across thousands of items, so items hold a
+// pointer into the table instead of their own copy. Interned values are
+// never released, and neither is the mutex guarding the table: a collection
+// thread may still be interning while RetroFE shuts down or reboots, and
+// items of cached collections keep pointing into the table.
+class InternedString
+{
+public:
+    static void initialize();
+
+    InternedString();
+    InternedString(const std::string &value);
+    InternedString &operator=(const std::string &value);
+    InternedString &operator=(const char *value);
+
+    operator const std::string &() const { return *value_; }
+    const std::string &str() const { return *value_; }
+    const char *c_str() const { return value_->c_str(); }
+    size_t length() const { return value_->length(); }
+    bool empty() const { return value_->empty(); }
+
+    bool operator==(const InternedString &rhs) const { return value_ == rhs.value_; }
+    bool operator!=(const InternedString &rhs) const { return value_ != rhs.value_; }
+    bool operator==(const std::string &rhs) const { return *value_ == rhs; }
+    bool operator!=(const std::string &rhs) const { return *value_ != rhs; }
+    bool operator==(const char *rhs) const { return *value_ == rhs; }
+    bool operator!=(const char *rhs) const { return *value_ != rhs; }
+
+private:
+    static const std::string *intern(const std::string &value);
+
+    const std::string *value_;
+
+    static const std::string                empty_;
+    static std::unordered_set<std::string> *table_;
+    static SDL_mutex                       *mutex_;
+};
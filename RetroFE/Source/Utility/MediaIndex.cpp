@@ -0,0 +1,449 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MediaIndex.h"
+#include "Utils.h"
+#include "Log.h"
+#include "../Database/Configuration.h"
+#include "../Database/DB.h"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <cctype>
+#include <utility>
+#include <sqlite3.h>
+
+// How long a directory listing is trusted before its mtime is checked again.
+static const Uint32 recheckInterval = 2000;
+
+std::unordered_map<std::string, MediaIndex::Directory *> MediaIndex::directories_;
+SDL_mutex *MediaIndex::mutex_ = NULL;
+
+
+void MediaIndex::initialize()
+{
+    if(!mutex_)
+    {
+        mutex_ = SDL_CreateMutex();
+    }
+}
+
+
+void MediaIndex::deInitialize()
+{
+    if(mutex_) SDL_LockMutex(mutex_);
+    for(std::unordered_map<std::string, Directory *>::iterator it = directories_.begin(); it != directories_.end(); ++it)
+    {
+        delete it->second;
+    }
+    directories_.clear();
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    if(mutex_)
+    {
+        SDL_DestroyMutex(mutex_);
+        mutex_ = NULL;
+    }
+}
+
+
+bool MediaIndex::findMatchingFile(std::string prefix, std::vector<std::string> &extensions, std::string &file)
+{
+    prefix = Configuration::convertToAbsolutePath(Configuration::absolutePath, prefix);
+
+    std::string path     = Utils::getDirectory(prefix);
+    std::string basename = Utils::getFileName(prefix);
+    bool        found    = false;
+    Uint32      now      = SDL_GetTicks();
+
+    if(mutex_) SDL_LockMutex(mutex_);
+
+    std::unordered_map<std::string, Directory *>::iterator it = directories_.find(path);
+
+    bool   cached  = (it != directories_.end());
+    bool   current = cached && it->second->validated && now - it->second->checked < recheckInterval;
+    bool   exists  = cached && it->second->exists;
+    time_t mtime   = cached ? it->second->mtime : 0;
+    bool   confirmed = cached && isConfirmed(it->second);
+
+    if(current)
+    {
+        found = match(it->second, path, basename, extensions, file);
+    }
+
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    if(current)
+    {
+        return found;
+    }
+
+    // check the directory and read it again if needed without holding the
+    // lock, so lookups in other directories are not held up by the disk
+    Directory listing;
+    time_t    modified = 0;
+    bool      changed  = !confirmed || getModified(path, modified) != exists || modified != mtime;
+
+    if(changed)
+    {
+        scan(path, &listing);
+    }
+
+    if(mutex_) SDL_LockMutex(mutex_);
+
+    it = directories_.find(path);
+    if(it == directories_.end())
+    {
+        it = directories_.insert(std::make_pair(path, new Directory())).first;
+        if(!changed)
+        {
+            scan(path, &listing);
+            changed = true;
+        }
+    }
+
+    Directory *directory = it->second;
+    if(changed)
+    {
+        std::swap(*directory, listing);
+    }
+    directory->checked   = now;
+    directory->validated = true;
+
+    found = match(directory, path, basename, extensions, file);
+
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    return found;
+}
+
+
+// Look up basename with each extension in turn. Called with the lock held.
+bool MediaIndex::match(Directory *directory, std::string &path, std::string &basename, std::vector<std::string> &extensions, std::string &file)
+{
+    bool found = false;
+
+    std::unordered_map<std::string, std::vector<std::string> >::iterator it = directory->files.find(toLower(basename));
+
+    if(it != directory->files.end())
+    {
+        std::vector<std::string> &names = it->second;
+
+        for(unsigned int i = 0; !found && i < extensions.size(); ++i)
+        {
+            std::string candidate = basename + "." + extensions[i];
+
+            for(unsigned int j = 0; !found && j < names.size(); ++j)
+            {
+#ifdef WIN32
+                found = (toLower(names[j]) == toLower(candidate));
+#else
+                found = (names[j] == candidate);
+#endif
+                if(found)
+                {
+                    file = Utils::combinePath(path, names[j]);
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+
+void MediaIndex::scan(std::string &path, Directory *directory)
+{
+    directory->scanned   = time(NULL);
+    directory->files.clear();
+    directory->checked   = SDL_GetTicks();
+    directory->validated = true;
+    directory->dirty     = true;
+    directory->entries   = 0;
+    directory->exists    = getModified(path, directory->mtime);
+
+    if(!directory->exists)
+    {
+        return;
+    }
+
+    DIR *dp = opendir(path.c_str());
+    struct dirent *dirp;
+
+    while(dp != NULL && (dirp = readdir(dp)) != NULL)
+    {
+        std::string name     = dirp->d_name;
+        size_t      position = name.find_last_of(".");
+
+        if(name == ".." || position == std::string::npos || position == 0)
+        {
+            continue;
+        }
+
+        directory->files[toLower(name.substr(0, position))].push_back(name);
+        directory->entries++;
+    }
+
+    if(dp)
+    {
+        closedir(dp);
+    }
+
+    Logger::write(Logger::ZONE_DEBUG, "MediaIndex", "Indexed " + std::to_string(directory->files.size()) + " name(s) in " + path);
+}
+
+
+// mtime only has a resolution of a second, so a file added in the same
+// second the directory was read would not change it. Such a listing is only
+// trusted once it is read again later.
+bool MediaIndex::isConfirmed(Directory *directory)
+{
+    return !directory->exists || directory->mtime < directory->scanned - 1;
+}
+
+
+bool MediaIndex::load(DB &db)
+{
+    sqlite3      *handle = db.handle;
+    sqlite3_stmt *stmt;
+    std::unordered_map<std::string, Directory *> loaded;
+    unsigned int  files = 0;
+
+    if(!createTables(db))
+    {
+        return false;
+    }
+
+    if(sqlite3_prepare_v2(handle, "SELECT path, mtime, entries, scanned FROM MediaDirectories;", -1, &stmt, 0) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "MediaIndex", "Unable to read media directories; they will be scanned. Error: " + std::string(sqlite3_errmsg(handle)));
+        return false;
+    }
+    while(sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        Directory *directory = new Directory();
+        directory->exists    = true;
+        directory->mtime     = (time_t)sqlite3_column_int64(stmt, 1);
+        directory->scanned   = (time_t)sqlite3_column_int64(stmt, 3);
+        directory->checked   = 0;
+        directory->validated = false;
+        directory->dirty     = false;
+        directory->entries   = (unsigned int)sqlite3_column_int(stmt, 2);
+        loaded[(char *)sqlite3_column_text(stmt, 0)] = directory;
+    }
+    sqlite3_finalize(stmt);
+
+    std::unordered_map<std::string, unsigned int> counts;
+
+    if(sqlite3_prepare_v2(handle, "SELECT directory, name FROM MediaFiles;", -1, &stmt, 0) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "MediaIndex", "Unable to read media files; directories will be scanned. Error: " + std::string(sqlite3_errmsg(handle)));
+        for(std::unordered_map<std::string, Directory *>::iterator it = loaded.begin(); it != loaded.end(); ++it)
+        {
+            delete it->second;
+        }
+        return false;
+    }
+    while(sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        std::string path = (char *)sqlite3_column_text(stmt, 0);
+        std::string name = (char *)sqlite3_column_text(stmt, 1);
+
+        std::unordered_map<std::string, Directory *>::iterator it = loaded.find(path);
+        if(it == loaded.end())
+        {
+            continue;
+        }
+
+        size_t position = name.find_last_of(".");
+        it->second->files[toLower(name.substr(0, position))].push_back(name);
+        counts[path]++;
+        files++;
+    }
+    sqlite3_finalize(stmt);
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    for(std::unordered_map<std::string, Directory *>::iterator it = loaded.begin(); it != loaded.end(); ++it)
+    {
+        // a listing that does not add up is dropped and read from disk again
+        if(counts[it->first] != it->second->entries || directories_.find(it->first) != directories_.end())
+        {
+            delete it->second;
+            continue;
+        }
+        directories_[it->first] = it->second;
+    }
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    Logger::write(Logger::ZONE_INFO, "MediaIndex", "Loaded " + std::to_string(files) + " file(s) in " + std::to_string(loaded.size()) + " media directories");
+
+    return true;
+}
+
+
+bool MediaIndex::save(DB &db)
+{
+    sqlite3      *handle = db.handle;
+    char         *error  = NULL;
+    sqlite3_stmt *deleteFiles     = NULL;
+    sqlite3_stmt *deleteDirectory = NULL;
+    sqlite3_stmt *insertDirectory = NULL;
+    sqlite3_stmt *insertFile      = NULL;
+    unsigned int  saved  = 0;
+
+    if(!createTables(db))
+    {
+        return false;
+    }
+
+    if(sqlite3_prepare_v2(handle, "DELETE FROM MediaFiles WHERE directory=?;", -1, &deleteFiles, 0) != SQLITE_OK ||
+       sqlite3_prepare_v2(handle, "DELETE FROM MediaDirectories WHERE path=?;", -1, &deleteDirectory, 0) != SQLITE_OK ||
+       sqlite3_prepare_v2(handle, "INSERT OR REPLACE INTO MediaDirectories (path, mtime, entries, scanned) VALUES (?,?,?,?);", -1, &insertDirectory, 0) != SQLITE_OK ||
+       sqlite3_prepare_v2(handle, "INSERT INTO MediaFiles (directory, name) VALUES (?,?);", -1, &insertFile, 0) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "MediaIndex", "Unable to save media directories; they will be scanned on the next start. Error: " + std::string(sqlite3_errmsg(handle)));
+        sqlite3_finalize(deleteFiles);
+        sqlite3_finalize(deleteDirectory);
+        sqlite3_finalize(insertDirectory);
+        sqlite3_finalize(insertFile);
+        return false;
+    }
+
+    if(mutex_) SDL_LockMutex(mutex_);
+    sqlite3_exec(handle, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, &error);
+
+    for(std::unordered_map<std::string, Directory *>::iterator it = directories_.begin(); it != directories_.end(); ++it)
+    {
+        Directory *directory = it->second;
+
+        if(!directory->dirty)
+        {
+            continue;
+        }
+
+        sqlite3_bind_text(deleteFiles, 1, it->first.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(deleteFiles);
+        sqlite3_reset(deleteFiles);
+
+        if(!directory->exists)
+        {
+            sqlite3_bind_text(deleteDirectory, 1, it->first.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(deleteDirectory);
+            sqlite3_reset(deleteDirectory);
+            directory->dirty = false;
+            continue;
+        }
+
+        sqlite3_bind_text(insertDirectory, 1, it->first.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(insertDirectory, 2, (sqlite3_int64)directory->mtime);
+        sqlite3_bind_int(insertDirectory, 3, (int)directory->entries);
+        sqlite3_bind_int64(insertDirectory, 4, (sqlite3_int64)directory->scanned);
+        sqlite3_step(insertDirectory);
+        sqlite3_reset(insertDirectory);
+
+        for(std::unordered_map<std::string, std::vector<std::string> >::iterator file = directory->files.begin(); file != directory->files.end(); ++file)
+        {
+            for(unsigned int i = 0; i < file->second.size(); ++i)
+            {
+                sqlite3_bind_text(insertFile, 1, it->first.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(insertFile, 2, file->second[i].c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_step(insertFile);
+                sqlite3_reset(insertFile);
+            }
+        }
+
+        directory->dirty = false;
+        saved++;
+    }
+
+    sqlite3_exec(handle, "COMMIT TRANSACTION;", NULL, NULL, &error);
+    if(mutex_) SDL_UnlockMutex(mutex_);
+
+    sqlite3_finalize(deleteFiles);
+    sqlite3_finalize(deleteDirectory);
+    sqlite3_finalize(insertDirectory);
+    sqlite3_finalize(insertFile);
+
+    if(saved > 0)
+    {
+        Logger::write(Logger::ZONE_INFO, "MediaIndex", "Saved " + std::to_string(saved) + " changed media director(ies)");
+    }
+
+    return true;
+}
+
+
+bool MediaIndex::createTables(DB &db)
+{
+    char *error = NULL;
+
+    std::string sql;
+    sql.append("CREATE TABLE IF NOT EXISTS MediaDirectories(");
+    sql.append("path TEXT PRIMARY KEY,");
+    sql.append("mtime INTEGER NOT NULL DEFAULT 0,");
+    sql.append("entries INTEGER NOT NULL DEFAULT 0,");
+    sql.append("scanned INTEGER NOT NULL DEFAULT 0);");
+    sql.append("CREATE TABLE IF NOT EXISTS MediaFiles(");
+    sql.append("directory TEXT NOT NULL,");
+    sql.append("name TEXT NOT NULL);");
+    sql.append("CREATE INDEX IF NOT EXISTS MediaFilesDirectory ON MediaFiles(directory);");
+
+    if(sqlite3_exec(db.handle, sql.c_str(), NULL, 0, &error) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "MediaIndex", "Unable to create media index tables. Error: " + std::string(error ? error : ""));
+        sqlite3_free(error);
+        return false;
+    }
+
+    // tables written before the scan time was kept lack the column; their
+    // listings read as scanned at 0 and are all confirmed again
+    sqlite3_stmt *stmt = NULL;
+    if(sqlite3_prepare_v2(db.handle, "SELECT scanned FROM MediaDirectories LIMIT 1;", -1, &stmt, 0) != SQLITE_OK &&
+       sqlite3_exec(db.handle, "ALTER TABLE MediaDirectories ADD COLUMN scanned INTEGER NOT NULL DEFAULT 0;", NULL, 0, &error) != SQLITE_OK)
+    {
+        Logger::write(Logger::ZONE_ERROR, "MediaIndex", "Unable to update media index tables. Error: " + std::string(error ? error : ""));
+        sqlite3_free(error);
+        return false;
+    }
+    sqlite3_finalize(stmt);
+
+    return true;
+}
+
+
+bool MediaIndex::getModified(std::string &path, time_t &mtime)
+{
+    struct stat info;
+
+    mtime = 0;
+    if(stat(path.c_str(), &info) != 0)
+    {
+        return false;
+    }
+    mtime = info.st_mtime;
+
+    return true;
+}
+
+
+std::string MediaIndex::toLower(std::string str)
+{
+    for(unsigned int i = 0; i < str.length(); ++i)
+    {
+        str[i] = (char)std::tolower((unsigned char)str[i]);
+    }
+
+    return str;
+}
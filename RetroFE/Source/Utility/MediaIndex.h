@@ -0,0 +1,72 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <ctime>
+
+// Answers "which <prefix>.<extension> exists" from an in-memory listing of
+// each media directory instead of probing the disk once per extension.
+// A directory is read the first time it is asked about and read again
+// when its modification time changes. Listings are kept in meta.db so a
+// restart only re-reads the directories that changed in the meantime.
+class DB;
+
+class MediaIndex
+{
+public:
+    static void initialize();
+    static void deInitialize();
+
+    // Restore listings saved by a previous run. Each one is checked against
+    // its directory's mtime before it is first used.
+    static bool load(DB &db);
+
+    // Write back listings that were (re)read since they were loaded.
+    static bool save(DB &db);
+
+    // Same contract as Utils::findMatchingFile: extensions are tried in
+    // order and the absolute path of the first existing file is returned.
+    static bool findMatchingFile(std::string prefix, std::vector<std::string> &extensions, std::string &file);
+
+private:
+    struct Directory
+    {
+        bool         exists;
+        time_t       mtime;
+        time_t       scanned; // wall clock time the listing was read
+        Uint32       checked;
+        bool         validated;
+        bool         dirty;
+        unsigned int entries;
+        // lowercase name without extension -> file names as found on disk; hashed
+        // since media directories can hold tens of thousands of files
+        std::unordered_map<std::string, std::vector<std::string> > files;
+    };
+
+    static bool match(Directory *directory, std::string &path, std::string &basename, std::vector<std::string> &extensions, std::string &file);
+    static void scan(std::string &path, Directory *directory);
+    static bool isConfirmed(Directory *directory);
+    static bool getModified(std::string &path, time_t &mtime);
+    static bool createTables(DB &db);
+    static std::string toLower(std::string str);
+
+    static std::unordered_map<std::string, Directory *> directories_;
+    static SDL_mutex *mutex_;
+};
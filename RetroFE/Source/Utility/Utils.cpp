@@ -274,3 +274,68 @@ int Utils::gcd( int a, int b )
         return a;
     return gcd( b, a % b );
 }
+
+
+// Return the character at pos and move pos past it. Bytes that do not start
+// a valid UTF-8 sequence are taken as Latin-1, which is what older meta
+// files are often written in.
+unsigned int Utils::decodeUtf8( const std::string &str, unsigned int &pos )
+{
+    unsigned char c = static_cast<unsigned char>( str[pos] );
+    unsigned int  length;
+    unsigned int  code;
+
+    if ( c < 0x80 )
+    {
+        pos += 1;
+        return c;
+    }
+    else if ( (c & 0xE0) == 0xC0 )
+    {
+        length = 2;
+        code   = c & 0x1F;
+    }
+    else if ( (c & 0xF0) == 0xE0 )
+    {
+        length = 3;
+        code   = c & 0x0F;
+    }
+    else if ( (c & 0xF8) == 0xF0 )
+    {
+        length = 4;
+        code   = c & 0x07;
+    }
+    else
+    {
+        pos += 1;
+        return c;
+    }
+
+    if ( pos + length > str.size( ) )
+    {
+        pos += 1;
+        return c;
+    }
+
+    for ( unsigned int i = 1; i < length; ++i )
+    {
+        unsigned char next = static_cast<unsigned char>( str[pos + i] );
+        if ( (next & 0xC0) != 0x80 )
+        {
+            pos += 1;
+            return c;
+        }
+        code = (code << 6) | (next & 0x3F);
+    }
+
+    // reject overlong forms, surrogates and values past the last code point
+    static const unsigned int minimum[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+    if ( code < minimum[length] || (code >= 0xD800 && code <= 0xDFFF) || code > 0x10FFFF )
+    {
+        pos += 1;
+        return c;
+    }
+
+    pos += length;
+    return code;
+}
@@ -0,0 +1,62 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "WorkQueue.h"
+
+void WorkQueue::run(std::vector<Job *> &jobs, int maxThreads)
+{
+    Batch batch;
+    batch.jobs = &jobs;
+    SDL_AtomicSet(&batch.next, 0);
+
+    std::vector<SDL_Thread *> threads;
+    int numThreads = (int)jobs.size() - 1;
+
+    if(numThreads > maxThreads - 1)
+    {
+        numThreads = maxThreads - 1;
+    }
+
+    for(int i = 0; i < numThreads; ++i)
+    {
+        SDL_Thread *thread = SDL_CreateThread(worker, "WorkQueue", (void *)&batch);
+        if(!thread)
+        {
+            break;
+        }
+        threads.push_back(thread);
+    }
+
+    worker((void *)&batch);
+
+    for(unsigned int i = 0; i < threads.size(); ++i)
+    {
+        SDL_WaitThread(threads[i], NULL);
+    }
+}
+
+
+int WorkQueue::worker(void *context)
+{
+    Batch *batch = static_cast<Batch *>(context);
+    int    index;
+
+    while((index = SDL_AtomicAdd(&batch->next, 1)) < (int)batch->jobs->size())
+    {
+        (*batch->jobs)[index]->run();
+    }
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Runs a batch of independent jobs on a few short-lived threads and
+// returns once all of them are done. The calling thread works too.
+class WorkQueue
+{
+public:
+    class Job
+    {
+    public:
+        virtual ~Job() {}
+        virtual void run() = 0;
+    };
+
+    static void run(std::vector<Job *> &jobs, int maxThreads);
+
+private:
+    struct Batch
+    {
+        std::vector<Job *> *jobs;
+        SDL_atomic_t        next;
+    };
+
+    static int worker(void *context);
+};